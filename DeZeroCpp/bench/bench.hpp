@@ -0,0 +1,110 @@
+#pragma once
+
+#include "../dezero/dezero.hpp"
+
+#ifdef _MSC_VER
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif	// #ifndef NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#endif	// #ifdef _MSC_VER
+
+// x`}[Np̋ʏ
+namespace bench
+{
+
+//----------------------------------
+// class
+//----------------------------------
+
+// p[^݂̂CiœKȂǂ̌vpj
+// rows x cols ̃p[^ count Alƌz͗ŏ
+class ParamLayer : public dz::layers::Layer
+{
+public:
+	// RXgN^
+	ParamLayer(size_t count, uint32_t rows, uint32_t cols)
+	{
+		for (size_t i = 0; i < count; i++) {
+			auto p = dz::as_parameter(dz::as_array(nc::random::rand<dz::data_t>({ rows, cols })), "p" + std::to_string(i));
+			p->grad = dz::as_variable(dz::as_array(nc::random::rand<dz::data_t>({ rows, cols })));
+			this->prop("p" + std::to_string(i)) = p;
+		}
+	}
+
+	// `digpȂj
+	dz::VariablePtrList forward(const dz::VariablePtrList& xs) override
+	{
+		return xs;
+	}
+};
+
+//----------------------------------
+// function
+//----------------------------------
+
+// Ԃvi}CNbj
+// PsĂ repeat sAP񂠂̕ςԂ
+template<typename F>
+inline double time_us(const F& f, int repeat = 10)
+{
+	f();
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < repeat; i++) {
+		f();
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::micro>(end - start).count() / repeat;
+}
+
+// Ɏgpe\̈̍őlvioCgj
+// obt@v[̎gpoCg̍őlȂOgp
+template<typename F>
+inline size_t peak_bytes(const F& f)
+{
+	auto& pool = dz::memory::BufferPool::get_instance();
+	pool.reset_statistics();
+	auto base = pool.statistics().bytes_in_use;
+	f();
+	return pool.statistics().peak_in_use - base;
+}
+
+// vZX̏풓iRSSj̃oCg
+// peak  true ȂőlԂi擾łȂł 0j
+inline size_t resident_bytes(bool peak = false)
+{
+#ifdef _MSC_VER
+	PROCESS_MEMORY_COUNTERS pmc;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0;
+	return peak ? pmc.PeakWorkingSetSize : pmc.WorkingSetSize;
+#elif defined(__linux__)
+	auto key = std::string(peak ? "VmHWM:" : "VmRSS:");
+	auto ifs = std::ifstream("/proc/self/status");
+	auto line = std::string();
+	while (std::getline(ifs, line)) {
+		if (line.compare(0, key.size(), key) == 0) return std::stoull(line.substr(key.size())) * 1024;
+	}
+	return 0;
+#else
+	return 0;
+#endif	// #ifdef _MSC_VER
+}
+
+// 풓̍ől݂̒lɖ߂iLinux ̂݁B̊ł͖߂Ȃ߉Ȃj
+inline void reset_peak_resident()
+{
+#ifdef __linux__
+	auto ofs = std::ofstream("/proc/self/clear_refs");
+	ofs << "5";
+#endif	// #ifdef __linux__
+}
+
+// oCg MB ɕϊ
+inline double to_mb(size_t bytes)
+{
+	return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+}	// namespace bench
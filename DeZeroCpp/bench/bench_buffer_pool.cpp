@@ -0,0 +1,127 @@
+#include "pch.h"
+
+#include "../dezero/dezero.hpp"
+#include "bench.hpp"
+
+using namespace dz;
+using namespace dz::models;
+namespace F = functions;
+namespace O = optimizers;
+
+namespace bench_buffer_pool {
+
+// obt@v[̒Ԃł̊mۉ񐔂̌v
+// wKPXebṽv[̊mۉ񐔁EVKmہi~Xj̉񐔂ƏԂA
+// LbVgꍇƁALbV̏ 1MB ɂꍇƁAXebv trim ăLbVɂiXebvōėpłȂ operator new ŊmۂjꍇŔr
+// ܂ÃXbhɊmہEԋpꍇ̏\v
+void bench_buffer_pool()
+{
+	const int warmup = 5;
+	const int steps = 20;
+
+	// step46  MLPiȃe\j
+	nc::random::seed(0);
+	auto x = as_variable(as_array(nc::random::rand<data_t>({ 100, 1 })));
+	auto t = as_variable(as_array(nc::random::rand<data_t>({ 100, 1 })));
+	auto model = std::make_shared<MLP>(std::vector<int>({ 10, 1 }));
+	auto optimizer = O::MomentumSGD(0.2);
+	optimizer.setup(model);
+	auto mlp_step = [&]() {
+		auto loss = F::mean_squared_error(t, (*model)(x)[0]);
+		model->cleargrads();
+		loss->backward();
+		optimizer.update();
+	};
+
+	// vfƂ̉Zi1000x1000 ̑傫ȃe\j
+	auto w = as_variable(as_array(nc::random::rand<data_t>({ 1000, 1000 })));
+	auto elementwise_step = [&]() {
+		auto loss = F::sum(F::sin(w) * w + F::exp(w) * w);
+		w->cleargrad();
+		loss->backward();
+	};
+
+	struct Workload
+	{
+		const char* name;
+		std::function<void()> step;
+	};
+	auto workloads = std::vector<Workload>({
+		{ "step46 MLP {10, 1}, batch 100", mlp_step },
+		{ "elementwise graph, 1000x1000", elementwise_step },
+	});
+
+	struct Mode
+	{
+		const char* name;
+		// LbV̏
+		size_t limit;
+		// Xebv trim 邩
+		bool trim;
+	};
+	auto modes = std::vector<Mode>({
+		{ "on", memory::BufferPool::default_cache_limit, false },
+		{ "1MB cap", size_t(1) << 20, false },
+		{ "trim", memory::BufferPool::default_cache_limit, true },
+	});
+
+	auto& pool = memory::BufferPool::get_instance();
+	for (const auto& wl : workloads) {
+		std::printf("%s\n", wl.name);
+		std::printf("  %-8s %12s %12s %12s %14s %10s\n", "cache", "allocs/step", "misses/step", "cached MB", "watermark MB", "us/step");
+		for (const auto& mode : modes) {
+			pool.set_cache_limit(mode.limit);
+			auto step = [&]() {
+				wl.step();
+				if (mode.trim) pool.trim();
+			};
+
+			// ǑvŊmۂ̈̉e߁ALbVɂĂn߂
+			// 傫ȃobt@̏Ԃ malloc  mmap ƃq[v̂ǂ炩mۂɍE邽߁A
+			//   LbV̌ʂ͊mۉ񐔁E~X񐔂Ŕr
+			// ܂AɐG郁̃y[WtH[g̉e߁AQvđg
+			pool.trim();
+			double us = 0;
+			memory::PoolStats s;
+			for (int round = 0; round < 2; round++) {
+				for (int i = 0; i < warmup; i++) step();
+				pool.reset_statistics();
+				auto start = std::chrono::steady_clock::now();
+				for (int i = 0; i < steps; i++) step();
+				auto end = std::chrono::steady_clock::now();
+				auto elapsed = std::chrono::duration<double, std::micro>(end - start).count() / steps;
+				us = round == 0 ? elapsed : std::min(us, elapsed);
+				s = pool.statistics();
+			}
+
+			std::printf("  %-8s %12.1f %12.1f %12.3f %14.3f %10.1f\n", mode.name,
+				static_cast<double>(s.hits + s.misses) / steps, static_cast<double>(s.misses) / steps,
+				bench::to_mb(s.bytes_cached), bench::to_mb(s.high_watermark), us);
+		}
+	}
+	pool.set_cache_limit(memory::BufferPool::default_cache_limit);
+
+	// ̃XbhɂmہEԋpiXbhƂɕʂ̃V[hgj
+	const int pairs = 1000000;
+	const size_t bytes = 4096;
+	std::printf("allocate/deallocate %zu bytes, %d pairs per thread\n", bytes, pairs);
+	std::printf("  %-8s %14s\n", "threads", "Mpairs/sec");
+	for (int n : { 1, 2, 4, 8 }) {
+		auto threads = std::vector<std::thread>();
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < n; i++) {
+			threads.emplace_back([&]() {
+				for (int k = 0; k < pairs; k++) {
+					pool.deallocate(pool.allocate(bytes), bytes);
+				}
+			});
+		}
+		for (auto& th : threads) {
+			th.join();
+		}
+		auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::printf("  %-8d %14.2f\n", n, static_cast<double>(pairs) * n / seconds / 1e6);
+	}
+}
+
+}
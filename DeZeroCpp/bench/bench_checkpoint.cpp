@@ -0,0 +1,47 @@
+#include "pch.h"
+
+#include "../dezero/dezero.hpp"
+#include "bench.hpp"
+
+using namespace dz;
+using namespace dz::models;
+namespace F = functions;
+
+namespace bench_checkpoint {
+
+// `FbN|Cg̊ԊuƂ̃gpʂƏԂ̌v
+// [ MLP ̏`dƋt`dP񂠂̃e\̈̍őgpʂƏԂAcheckpoint_interval ςĔr
+void bench_checkpoint()
+{
+	const int depth = 32;
+	const int width = 128;
+	const uint32_t batch = 128;
+	const int repeat = 3;
+
+	nc::random::seed(0);
+	auto x = as_variable(as_array(nc::random::rand<data_t>({ batch, static_cast<uint32_t>(width) })));
+	auto t = as_variable(as_array(nc::zeros<data_t>({ batch, 1 })));
+	auto sizes = std::vector<int>(depth - 1, width);
+	sizes.push_back(1);
+
+	std::printf("MLP: %d layers x %d units, batch %u\n", depth, width, batch);
+	std::printf("%-10s %12s %12s\n", "interval", "peak MB", "ms/iter");
+	for (size_t interval : { 0, 1, 2, 4, 8, 16 }) {
+		nc::random::seed(0);
+		auto model = MLP(sizes, F::sigmoid, interval);
+		auto step = [&]() {
+			auto loss = F::mean_squared_error(model(x)[0], t);
+			model.cleargrads();
+			loss->backward();
+		};
+		// d݂̏v珜
+		step();
+		auto peak = bench::peak_bytes(step);
+		auto us = bench::time_us(step, repeat);
+		if (interval == 0) std::printf("%-10s", "none");
+		else std::printf("%-10zu", interval);
+		std::printf(" %12.2f %12.1f\n", bench::to_mb(peak), us / 1000);
+	}
+}
+
+}
@@ -0,0 +1,85 @@
+#include "pch.h"
+
+#include "../dezero/dezero.hpp"
+#include "bench.hpp"
+
+using namespace dz;
+using namespace dz::models;
+namespace F = functions;
+
+namespace bench_hvp {
+
+// t`dQsidouble backwardjwbZsƃxNg̐
+// z g vZOttŋ߁Asum(gEv) xt`d Hv 𓾂
+NdArrayPtrList double_backward_hvp(const std::function<VariablePtr()>& loss_fn, const VariablePtrList& params, const NdArrayPtrList& v)
+{
+	for (const auto& p : params) p->cleargrad();
+	auto loss = loss_fn();
+	loss->backward(false, true);
+
+	auto gv = VariablePtr();
+	auto gs = VariablePtrList();
+	for (size_t i = 0; i < params.size(); i++) {
+		gs.push_back(params[i]->grad);
+		auto term = F::sum(params[i]->grad * as_variable(v[i]));
+		gv = gv ? gv + term : term;
+	}
+	for (const auto& p : params) p->cleargrad();
+	gv->backward();
+
+	auto hv = NdArrayPtrList();
+	for (const auto& p : params) {
+		hv.push_back(p->grad ? p->grad->data : as_array(nc::zeros_like<data_t>(*p->data)));
+	}
+	return hv;
+}
+
+// wbZsƃxNg̐ς̏Ԃƃgpʂ̌v
+// MLP ̑ɂāAutils::hvpiforward-over-reversej double backward ̂P񂠂̏Ԃ
+// e\̈̍őgpʂridiff ͂Q̌ʂ̗vfƂ̍̍őlj
+void bench_hvp()
+{
+	const uint32_t batch = 128;
+	const uint32_t features = 64;
+	const int repeat = 5;
+
+	nc::random::seed(0);
+	auto x = as_variable(as_array(nc::random::rand<data_t>({ batch, features })));
+	auto t = as_variable(as_array(nc::random::rand<data_t>({ batch, 1 })));
+
+	std::printf("%-10s %-12s %12s %12s %12s\n", "width", "method", "peak MB", "ms/iter", "diff");
+	for (int width : { 64, 256, 512 }) {
+		nc::random::seed(0);
+		auto model = MLP({ width, width, 1 });
+		auto loss_fn = [&]() { return F::mean_squared_error(model(x)[0], t); };
+		// d݂Ăp[^ƕ v pӂ
+		loss_fn();
+		auto params = VariablePtrList();
+		auto v = NdArrayPtrList();
+		for (const auto& p : model.params()) {
+			params.push_back(p);
+			v.push_back(as_array(nc::random::rand<data_t>(p->data->shape())));
+		}
+
+		auto hv0 = NdArrayPtrList();
+		auto hv1 = NdArrayPtrList();
+		auto fwd_over_rev = [&]() { hv0 = utils::hvp(loss_fn, params, v); };
+		auto double_backward = [&]() { hv1 = double_backward_hvp(loss_fn, params, v); };
+
+		auto peak0 = bench::peak_bytes(fwd_over_rev);
+		auto us0 = bench::time_us(fwd_over_rev, repeat);
+		auto peak1 = bench::peak_bytes(double_backward);
+		auto us1 = bench::time_us(double_backward, repeat);
+
+		data_t diff = 0;
+		for (size_t i = 0; i < hv0.size(); i++) {
+			for (uint32_t k = 0; k < hv0[i]->size(); k++) {
+				diff = std::max(diff, std::abs((*hv0[i])[k] - (*hv1[i])[k]));
+			}
+		}
+		std::printf("%-10d %-12s %12.2f %12.1f %12s\n", width, "fwd-over-rev", bench::to_mb(peak0), us0 / 1000, "");
+		std::printf("%-10s %-12s %12.2f %12.1f %12.3g\n", "", "double bwd", bench::to_mb(peak1), us1 / 1000, diff);
+	}
+}
+
+}
@@ -0,0 +1,46 @@
+#include "pch.h"
+
+#include "../dezero/dezero.hpp"
+#include "bench.hpp"
+
+using namespace dz;
+namespace F = functions;
+
+namespace bench_jacobian {
+
+// RršvZ[hƂ̏Ԃ̌v
+// f(x) = 2 tanh(xW) + sin(xW) ̃RrsA[hi̗͂vfƂ jvpj
+// t[hio̗͂vfƂɋt`djŋ߂Ĕridiff ͂Q̌ʂ̗vfƂ̍̍őlj
+// ͂Ȃo͂ꍇƁA̋t̏ꍇvBAuto ͓̗͂vfo͈ȉȂ珇[hI
+void bench_jacobian()
+{
+	struct Case
+	{
+		uint32_t inputs;
+		uint32_t outputs;
+	};
+	auto cases = std::vector<Case>({ { 4, 10000 }, { 10000, 4 } });
+
+	std::printf("%-16s %12s %12s %12s %12s\n", "in x out", "forward ms", "reverse ms", "auto ms", "diff");
+	for (const auto& c : cases) {
+		nc::random::seed(0);
+		auto W = as_variable(as_array(nc::random::rand<data_t>({ c.inputs, c.outputs })));
+		auto x = as_variable(as_array(nc::random::rand<data_t>({ 1, c.inputs })));
+		auto f = [&](const VariablePtr& x) { return F::tanh(F::matmul(x, W)) * 2.0 + F::sin(F::matmul(x, W)); };
+
+		auto j_forward = NdArray();
+		auto j_reverse = NdArray();
+		auto forward_us = bench::time_us([&]() { j_forward = utils::jacobian(f, x, utils::JacobianMode::Forward); }, 1);
+		auto reverse_us = bench::time_us([&]() { j_reverse = utils::jacobian(f, x, utils::JacobianMode::Reverse); }, 1);
+		auto auto_us = bench::time_us([&]() { utils::jacobian(f, x); }, 1);
+
+		data_t diff = 0;
+		for (uint32_t i = 0; i < j_forward.size(); i++) {
+			diff = std::max(diff, std::abs(j_forward[i] - j_reverse[i]));
+		}
+		auto name = std::to_string(c.inputs) + " x " + std::to_string(c.outputs);
+		std::printf("%-16s %12.1f %12.1f %12.1f %12.3g\n", name.c_str(), forward_us / 1000, reverse_us / 1000, auto_us / 1000, diff);
+	}
+}
+
+}
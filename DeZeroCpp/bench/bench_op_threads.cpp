@@ -0,0 +1,67 @@
+#include "pch.h"
+
+#include "../dezero/dezero.hpp"
+#include "bench.hpp"
+
+using namespace dz;
+namespace F = functions;
+namespace O = optimizers;
+
+namespace bench_op_threads {
+
+// ZƂ̃Xbhɂ鏈Ԃ̌v
+// Xbhv[geJ[livfƂ̉ZEWEsρEp[^̍XVĵP񂠂̏ԂA
+// 񏈗ɎgXbh 1/2/4/8/16 ƕςĔriʓ͂PXbhɑ΂鑬xj
+void bench_op_threads()
+{
+	const uint32_t size = 1000;
+	const uint32_t gemm_size = 256;
+	const int repeat = 10;
+
+	nc::random::seed(0);
+	auto a = as_array(nc::random::rand<data_t>({ size, size }));
+	auto b = as_array(nc::random::rand<data_t>({ size, size }));
+	auto m0 = nc::random::rand<data_t>({ gemm_size, gemm_size });
+	auto m1 = nc::random::rand<data_t>({ gemm_size, gemm_size });
+	auto x = as_variable(a);
+	auto y = as_variable(b);
+	auto model = std::make_shared<bench::ParamLayer>(10, size, size);
+	auto optimizer = O::MomentumSGD(0.01);
+	optimizer.setup(model);
+
+	struct Workload
+	{
+		const char* name;
+		std::function<void()> op;
+	};
+	auto workloads = std::vector<Workload>({
+		{ "exp 1000x1000", [&]() { F::exp(x); } },
+		{ "mul 1000x1000", [&]() { x * y; } },
+		{ "sum 1000x1000", [&]() { utils::sum(*a, nc::Axis::NONE); } },
+		{ "sum rows 1000x1000", [&]() { utils::sum(*a, nc::Axis::ROW); } },
+		{ "dot 256x256", [&]() { utils::dot(m0, m1); } },
+		{ "MomentumSGD 10x1M", [&]() { optimizer.update(); } },
+	});
+
+	const auto thread_counts = std::vector<size_t>({ 1, 2, 4, 8, 16 });
+	std::printf("%-20s", "op (us)");
+	for (auto n : thread_counts) std::printf(" %16zu", n);
+	std::printf("\n");
+
+	auto old_threads = parallel::num_threads();
+	for (const auto& wl : workloads) {
+		std::printf("%-20s", wl.name);
+		double base = 0;
+		for (auto n : thread_counts) {
+			parallel::set_num_threads(n);
+			UsingConfig with("enable_backprop", false);
+			auto us = bench::time_us(wl.op, repeat);
+			if (n == 1) base = us;
+			std::printf(" %9.1f (%4.2f)", us, base / us);
+		}
+		std::printf("\n");
+	}
+	parallel::set_num_threads(old_threads);
+}
+
+}
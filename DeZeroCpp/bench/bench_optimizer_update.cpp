@@ -0,0 +1,67 @@
+#include "pch.h"
+
+#include "../dezero/dezero.hpp"
+#include "bench.hpp"
+
+using namespace dz;
+namespace O = optimizers;
+
+namespace bench_optimizer_update {
+
+// p[^XV̌vi1000p[^j
+// NdArray ̎łPp[^XVꍇƁAev[gōXVꍇr
+void bench_optimizer_update()
+{
+	const size_t count = 10;
+	const uint32_t rows = 1000;
+	const uint32_t cols = 1000;
+	const int repeat = 5;
+	double lr = 1e-6;
+	double momentum = 0.9;
+
+	nc::random::seed(0);
+	auto model = std::make_shared<bench::ParamLayer>(count, rows, cols);
+	std::printf("parameters: %zu x %ux%u = %zu\n", count, rows, cols, count * rows * cols);
+
+	// SGDFNdArray ̎iꎞzj
+	auto t_expr = bench::time_us([&]() {
+		for (auto& p : model->params()) {
+			*(p->data) -= lr * *(p->grad->data);
+		}
+	}, repeat);
+
+	// SGDFev[giꎞz炸P̃[vŕ]j
+	auto t_tmpl = bench::time_us([&]() {
+		for (auto& p : model->params()) {
+			expr::ref(*p->data) -= lr * expr::ref(*p->grad->data);
+		}
+	}, repeat);
+
+	// MomentumSGDFNdArray ̎ix̍XVƃp[^̍XVłR̃[vj
+	auto vs = std::vector<NdArray>();
+	for (auto& p : model->params()) {
+		vs.push_back(nc::zeros<data_t>(p->data->shape()));
+	}
+	auto t_mexpr = bench::time_us([&]() {
+		size_t i = 0;
+		for (auto& p : model->params()) {
+			vs[i] *= momentum;
+			vs[i] -= lr * *(p->grad->data);
+			*(p->data) += vs[i];
+			i++;
+		}
+	}, repeat);
+
+	// MomentumSGDFœKNXiev[gőx̍XVƃp[^̍XV̂Q̃[vj
+	auto msgd = O::MomentumSGD(lr, momentum);
+	msgd.setup(model);
+	auto t_msgd = bench::time_us([&]() { msgd.update(); }, repeat);
+
+	std::printf("%-34s %10s\n", "update", "ms/step");
+	std::printf("%-34s %10.1f\n", "SGD NdArray expression", t_expr / 1000);
+	std::printf("%-34s %10.1f\n", "SGD expression template", t_tmpl / 1000);
+	std::printf("%-34s %10.1f\n", "MomentumSGD NdArray expression", t_mexpr / 1000);
+	std::printf("%-34s %10.1f\n", "MomentumSGD expression template", t_msgd / 1000);
+}
+
+}
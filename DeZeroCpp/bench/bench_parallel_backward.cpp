@@ -0,0 +1,80 @@
+#include "pch.h"
+
+#include "../dezero/dezero.hpp"
+#include "bench.hpp"
+
+using namespace dz;
+namespace F = functions;
+
+namespace bench_parallel_backward {
+
+VariablePtr goldstein(const VariablePtr& x, const VariablePtr& y)
+{
+	auto z =
+		(1 + power((x + y + 1), 2) * (19 - 14 * x + 3 * power(x, 2) - 14 * y + 6 * x * y + 3 * power(y, 2))) *
+		(30 + power((2 * x - 3 * y), 2) * (18 - 32 * x + 12 * power(x, 2) + 48 * y - 36 * x * y + 27 * power(y, 2)));
+	return z;
+}
+
+// ̋t`d̃XbhƂ̏Ԃ̌v
+// Ɨ}vZOtijƁAȊ֐AȂvZOtiXJ[jɂāA
+// ̋t`dƁAXbhς̋t`d́A`dƋt`dP񂠂̏Ԃr
+void bench_parallel_backward()
+{
+	const int branches = 16;
+	const uint32_t size = 128;
+
+	nc::random::seed(0);
+	auto x = as_variable(as_array(nc::random::rand<data_t>({ size, size })));
+	auto ws = VariablePtrList();
+	for (int i = 0; i < branches; i++) {
+		ws.push_back(as_variable(as_array(nc::random::rand<data_t>({ size, size }))));
+	}
+	auto a = as_variable(as_array(1.0));
+	auto b = as_variable(as_array(1.0));
+
+	struct Workload
+	{
+		const char* name;
+		std::function<VariablePtr()> forward;
+		int repeat;
+	};
+	auto workloads = std::vector<Workload>({
+		{ "wide: 16 x matmul/tanh, 128x128", [&]() {
+			auto y = VariablePtr();
+			for (const auto& w : ws) {
+				auto h = F::sum(F::tanh(F::matmul(x, w)));
+				y = y ? y + h : h;
+			}
+			return y;
+		}, 20 },
+		{ "scalar: step24 goldstein", [&]() { return goldstein(a, b); }, 2000 },
+	});
+
+	auto old_threads = parallel::num_threads();
+	for (const auto& wl : workloads) {
+		std::printf("%s\n", wl.name);
+		std::printf("  %-12s %12s\n", "backward", "us/iter");
+		auto measure = [&](bool parallel) {
+			UsingConfig with("parallel_backward", parallel);
+			auto step = [&]() {
+				auto y = wl.forward();
+				x->cleargrad();
+				for (const auto& w : ws) w->cleargrad();
+				a->cleargrad();
+				b->cleargrad();
+				y->backward();
+			};
+			return bench::time_us(step, wl.repeat);
+		};
+		std::printf("  %-12s %12.1f\n", "sequential", measure(false));
+		for (size_t n : { 1, 2, 4, 8 }) {
+			parallel::set_num_threads(n);
+			auto us = measure(true);
+			std::printf("  %zu %-10s %12.1f\n", n, n == 1 ? "thread" : "threads", us);
+		}
+		parallel::set_num_threads(old_threads);
+	}
+}
+
+}
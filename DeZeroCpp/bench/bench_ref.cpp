@@ -0,0 +1,60 @@
+#include "pch.h"
+
+#include "../dezero/dezero.hpp"
+#include "bench.hpp"
+
+using namespace dz;
+
+namespace bench_ref {
+
+// QƃJEg̕Ƃ̌vZOt̏Ԃ̌v
+// XJ̌vZOtiy = y * w + 1  depth AZ 2 * depth jɂāAPOt
+// \zi`djEt`dEj̏Ԃv
+// DEZERO_INTRUSIVE_REF ̗LŃrhĔriN^̎QƃJEg std::shared_ptrj
+void bench_ref()
+{
+	const int depth = 200;
+	const int iters = 2000;
+	const int warmup = 100;
+
+#ifdef DEZERO_INTRUSIVE_REF
+	std::printf("reference: intrusive (DEZERO_INTRUSIVE_REF)\n");
+#else
+	std::printf("reference: std::shared_ptr\n");
+#endif	// #ifdef DEZERO_INTRUSIVE_REF
+
+	nc::random::seed(0);
+	auto w = as_variable(as_array(nc::random::rand<data_t>({ 1, 1 })));
+	double build_s = 0;
+	double backward_s = 0;
+	double teardown_s = 0;
+	for (int i = 0; i < warmup + iters; i++) {
+		auto t0 = std::chrono::steady_clock::now();
+		auto x = as_variable(as_array(nc::random::rand<data_t>({ 1, 1 })));
+		auto y = x;
+		for (int d = 0; d < depth; d++) {
+			y = y * w + 1.0;
+		}
+		auto t1 = std::chrono::steady_clock::now();
+		y->backward();
+		auto t2 = std::chrono::steady_clock::now();
+		y = nullptr;
+		x = nullptr;
+		w->cleargrad();
+		auto t3 = std::chrono::steady_clock::now();
+		if (i >= warmup) {
+			build_s += std::chrono::duration<double>(t1 - t0).count();
+			backward_s += std::chrono::duration<double>(t2 - t1).count();
+			teardown_s += std::chrono::duration<double>(t3 - t2).count();
+		}
+	}
+
+	std::printf("%-12s %12s\n", "phase", "us/graph");
+	std::printf("%-12s %12.2f\n", "build", build_s / iters * 1e6);
+	std::printf("%-12s %12.2f\n", "backward", backward_s / iters * 1e6);
+	std::printf("%-12s %12.2f\n", "teardown", teardown_s / iters * 1e6);
+	std::printf("%-12s %12.2f\n", "total", (build_s + backward_s + teardown_s) / iters * 1e6);
+	std::printf("(%d ops per graph)\n", 2 * depth);
+}
+
+}
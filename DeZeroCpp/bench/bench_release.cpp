@@ -0,0 +1,65 @@
+#include "pch.h"
+
+#include "../dezero/dezero.hpp"
+#include "bench.hpp"
+
+using namespace dz;
+using namespace dz::models;
+namespace F = functions;
+namespace O = optimizers;
+
+namespace bench_release {
+
+// ԃf[^ɂ郁gpʂ̌v
+// MLP ̊wKPXebṽe\̈̍őgpʁA풓iRSSj̍ől̑ƏԂAConfig  release_data ̗LŔr
+// release_data LȏꍇA[ŨR[hQƂȂԃf[^̂At`dŎgȂ̂͏`d̓rŁA
+// @e֐ need_inputs / need_outputs Ő錾p҂ȂȂ̂͋t`d̓rŉ
+// RSS ̍ől Windows ł͖߂Ȃ߁Agpʂ̏Ȃ release_data L̏ꍇɌv
+void bench_release()
+{
+	const int depth = 8;
+	const uint32_t width = 256;
+	const uint32_t batch = 256;
+	const int repeat = 5;
+
+	nc::random::seed(0);
+	auto x = as_variable(as_array(nc::random::rand<data_t>({ batch, width })));
+	auto t = as_variable(as_array(nc::random::rand<data_t>({ batch, 1 })));
+	auto sizes = std::vector<int>(depth - 1, static_cast<int>(width));
+	sizes.push_back(1);
+
+	std::printf("MLP: %d layers x %u units, batch %u\n", depth, width, batch);
+	std::printf("%-14s %12s %12s %12s %12s\n", "release_data", "peak MB", "RSS MB", "ms/step", "loss");
+	for (bool release : { true, false }) {
+		UsingConfig with("release_data", release);
+
+		nc::random::seed(0);
+		auto model = std::make_shared<MLP>(sizes);
+		auto optimizer = O::SGD(0.01);
+		optimizer.setup(model);
+		data_t loss_value = 0;
+		auto step = [&]() {
+			auto loss = F::mean_squared_error((*model)(x)[0], t);
+			model->cleargrads();
+			loss->backward();
+			optimizer.update();
+			loss_value = (*loss->data)[0];
+		};
+		// d݂̏v珜
+		step();
+
+		// obt@v[̃LbVĂPXebvsARSS ̍ől̑߂
+		memory::BufferPool::get_instance().trim();
+		bench::reset_peak_resident();
+		auto rss_base = bench::resident_bytes();
+		step();
+		auto rss_peak = bench::resident_bytes(true);
+		auto rss = rss_peak > rss_base ? rss_peak - rss_base : 0;
+
+		auto peak = bench::peak_bytes(step);
+		auto us = bench::time_us(step, repeat);
+		std::printf("%-14s %12.2f %12.2f %12.1f %12.6f\n", release ? "on" : "off", bench::to_mb(peak), bench::to_mb(rss), us / 1000, loss_value);
+	}
+}
+
+}
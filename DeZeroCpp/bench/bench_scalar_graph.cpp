@@ -0,0 +1,100 @@
+#include "pch.h"
+
+#include "../dezero/dezero.hpp"
+#include "bench.hpp"
+
+using namespace dz;
+
+namespace bench_scalar_graph {
+
+// XJ[̌vZOt̏Ԃ̌v
+// step24/28/29/33 ̊֐ɂāA`dƋt`dP񂠂̏ԂƁAobt@v[̊mۉ񐔂v
+
+VariablePtr goldstein(const VariablePtr& x, const VariablePtr& y)
+{
+	auto z =
+		(1 + power((x + y + 1), 2) * (19 - 14 * x + 3 * power(x, 2) - 14 * y + 6 * x * y + 3 * power(y, 2))) *
+		(30 + power((2 * x - 3 * y), 2) * (18 - 32 * x + 12 * power(x, 2) + 48 * y - 36 * x * y + 27 * power(y, 2)));
+	return z;
+}
+
+VariablePtr rosenbrock(const VariablePtr& x0, const VariablePtr& x1)
+{
+	auto y = 100.0 * power((x1 - power(x0, 2)), 2) + power((x0 - 1.0), 2);
+	return y;
+}
+
+VariablePtr f(const VariablePtr& x)
+{
+	auto y = power(x, 4) - 2 * power(x, 2);
+	return y;
+}
+
+void bench_scalar_graph()
+{
+	const int repeat = 20000;
+
+	auto x = as_variable(as_array(1.0));
+	auto y = as_variable(as_array(1.0));
+
+	struct Workload
+	{
+		const char* name;
+		std::function<void()> step;
+	};
+	auto workloads = std::vector<Workload>({
+		// step24
+		{ "step24 sphere", [&]() {
+			auto z = power(x, 2) + power(y, 2);
+			x->cleargrad();
+			y->cleargrad();
+			z->backward();
+		} },
+		{ "step24 matyas", [&]() {
+			auto z = 0.26 * (power(x, 2) + power(y, 2)) - 0.48 * x * y;
+			x->cleargrad();
+			y->cleargrad();
+			z->backward();
+		} },
+		{ "step24 goldstein", [&]() {
+			auto z = goldstein(x, y);
+			x->cleargrad();
+			y->cleargrad();
+			z->backward();
+		} },
+		// step28il͍XVȂj
+		{ "step28 rosenbrock", [&]() {
+			auto z = rosenbrock(x, y);
+			x->cleargrad();
+			y->cleargrad();
+			z->backward();
+		} },
+		// step29
+		{ "step29 f", [&]() {
+			auto z = f(x);
+			x->cleargrad();
+			z->backward();
+		} },
+		// step33iQKj
+		{ "step33 f, 2nd order", [&]() {
+			auto z = f(x);
+			x->cleargrad();
+			z->backward(false, true);
+			auto gx = x->grad;
+			x->cleargrad();
+			gx->backward();
+		} },
+	});
+
+	auto& pool = memory::BufferPool::get_instance();
+	std::printf("%-22s %12s %12s\n", "graph", "us/iter", "allocs/iter");
+	for (const auto& wl : workloads) {
+		auto us = bench::time_us(wl.step, repeat);
+		pool.reset_statistics();
+		wl.step();
+		auto s = pool.statistics();
+		std::printf("%-22s %12.2f %12zu\n", wl.name, us, s.hits + s.misses);
+	}
+}
+
+}
@@ -0,0 +1,36 @@
+#include "pch.h"
+
+#include "../dezero/dezero.hpp"
+#include "bench.hpp"
+
+using namespace dz;
+namespace F = functions;
+
+namespace bench_small_vector {
+
+// ȌvZOt̉Z̏\̌v
+// y = sin(y) * x + y  depth ȂXJ̌vZOtɂāA`dƋt`dŎsZ̐Pbŕ\
+// ͂Əo͂̃Xg SmallVector ̓̈Ɏ܂邽߁AZƂ̃Xg̊mۂꍇ̐\
+void bench_small_vector()
+{
+	const int iters = 2000;
+	const int depth = 50;
+
+	std::printf("%-8s %12s %14s %12s\n", "depth", "us/iter", "ops/sec", "grad");
+	for (int d : { 1, 10, depth }) {
+		auto x = as_variable(as_array({ 0.5 }));
+		auto us = bench::time_us([&]() {
+			auto y = x;
+			for (int i = 0; i < d; i++) {
+				y = F::sin(y) * x + y;
+			}
+			x->cleargrad();
+			y->backward();
+		}, iters);
+		// `d sin/mul/addAt`dłꂼ backward
+		auto ops = 6.0 * d;
+		std::printf("%-8d %12.2f %14.0f %12.6g\n", d, us, ops / us * 1e6, (*x->grad->data)[0]);
+	}
+}
+
+}
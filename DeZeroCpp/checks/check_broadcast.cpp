@@ -0,0 +1,56 @@
+#include "pch.h"
+
+#include "../dezero/dezero.hpp"
+
+using namespace dz;
+namespace F = functions;
+
+namespace check_broadcast {
+
+// ҒlƗvfƂɈv邩
+bool equal(const NdArray& a, const NdArray& b)
+{
+	return a.shape() == b.shape() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+// u[hLXg̊mF
+// xNgEsxNgEXJ[ 3 x 4 Ƀu[hLXgʂƁA
+// F::broadcast_to ̋t`dŌ̌`ɍvzҒlƈv邩mF
+// SĈv true Ԃ
+bool check_broadcast()
+{
+	struct Case
+	{
+		const char* name;
+		NdArray x;
+		NdArray expected;
+		NdArray expected_grad;
+	};
+	auto cases = std::vector<Case>({
+		{ "column 3x1 -> 3x4", NdArray({ 1, 2, 3 }).transpose(),
+			NdArray({ { 1, 1, 1, 1 }, { 2, 2, 2, 2 }, { 3, 3, 3, 3 } }), NdArray({ 4, 4, 4 }).transpose() },
+		{ "row 1x4 -> 3x4", NdArray({ 1, 2, 3, 4 }),
+			NdArray({ { 1, 2, 3, 4 }, { 1, 2, 3, 4 }, { 1, 2, 3, 4 } }), NdArray({ 3, 3, 3, 3 }) },
+		{ "scalar 1x1 -> 3x4", NdArray({ 5 }),
+			NdArray({ { 5, 5, 5, 5 }, { 5, 5, 5, 5 }, { 5, 5, 5, 5 } }), NdArray({ 12 }) },
+	});
+	auto shape = nc::Shape(3, 4);
+
+	bool all_ok = true;
+	std::printf("  %-20s %-8s %s\n", "case", "forward", "backward");
+	for (const auto& c : cases) {
+		auto forward_ok = equal(utils::broadcast_to(c.x, shape), c.expected);
+
+		auto x = as_variable(as_array(c.x));
+		auto y = F::broadcast_to(x, shape);
+		y->backward();
+		auto backward_ok = equal(*y->data, c.expected) && equal(*x->grad->data, c.expected_grad);
+
+		all_ok = all_ok && forward_ok && backward_ok;
+		std::printf("  %-20s %-8s %s\n", c.name, forward_ok ? "OK" : "NG", backward_ok ? "OK" : "NG");
+	}
+	std::printf("%s\n", all_ok ? "all cases match" : "MISMATCH");
+	return all_ok;
+}
+
+}
@@ -0,0 +1,92 @@
+#include "pch.h"
+
+#include "../dezero/dezero.hpp"
+
+using namespace dz;
+using namespace dz::models;
+namespace F = functions;
+
+namespace check_gradients {
+
+// mFʂPs\iseconds Ȃ珈Ԃ͕\Ȃj
+void print_result(const utils::GradCheckResult& r, double seconds)
+{
+	std::printf("  %-28s %10zu %14.3g %8s", r.name.c_str(), r.count, r.max_rel_error, r.passed ? "OK" : "NG");
+	if (seconds >= 0) std::printf(" %10.3f", seconds);
+	std::printf("\n");
+}
+
+// ԂvĊmFs
+template<typename F>
+utils::GradCheckResult timed(const F& f, double& seconds)
+{
+	auto start = std::chrono::steady_clock::now();
+	auto r = f();
+	seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return r;
+}
+
+// zmF
+// utils::gradient_check_all őS֐̋t`d𐔒lƔׁA֐Ƃ̌ʂ\
+// ܂AMLP ̑̃wbZsƃxNg̐ςƁAvf 100 ̓͂̌zmFiɂjsAԂ\
+// SĈv true Ԃ
+bool check_gradients()
+{
+	std::printf("  %-28s %10s %14s %8s %10s\n", "function", "compared", "max rel error", "result", "seconds");
+
+	bool all_passed = true;
+	double seconds = 0;
+
+	// S֐
+	auto start = std::chrono::steady_clock::now();
+	auto results = utils::gradient_check_all();
+	seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	for (const auto& r : results) {
+		print_result(r, -1);
+		all_passed = all_passed && r.passed;
+	}
+	std::printf("  %-28s %10s %14s %8s %10.3f\n", "(all functions)", "", "", "", seconds);
+
+	// wbZsƃxNg̐
+	{
+		UsingSeed with(0);
+		auto model = std::make_shared<MLP>(std::vector<int>({ 5, 3, 1 }));
+		auto x = as_variable(as_array(nc::random::rand<data_t>({ 8, 2 })));
+		auto t = as_variable(as_array(nc::random::rand<data_t>({ 8, 1 })));
+		(*model)(x);
+		auto params = VariablePtrList();
+		for (const auto& p : model->params()) params.push_back(p);
+		auto r = timed([&]() {
+			return utils::hvp_check("hvp: MLP {5, 3, 1}", [&]() { return F::mean_squared_error((*model)(x)[0], t); }, params);
+		}, seconds);
+		print_result(r, seconds);
+		all_passed = all_passed && r.passed;
+	}
+
+	// vf 100 ̓
+	{
+		nc::random::seed(0);
+		auto x = as_variable(as_array(nc::random::rand<data_t>({ 1000, 1000 })));
+		auto a = as_variable(as_array(nc::random::rand<data_t>({ 1000, 500 })));
+		auto b = as_variable(as_array(nc::random::rand<data_t>({ 1000, 500 })));
+		auto cases = std::vector<std::pair<std::string, std::function<utils::GradCheckResult()>>>({
+			{ "1M: tanh", [&]() { return utils::gradient_check("1M: tanh", [](const VariablePtrList& xs) { return F::tanh(xs); }, { x }); } },
+			{ "1M: sin(a) * b", [&]() {
+				return utils::gradient_check("1M: sin(a) * b", [](const VariablePtrList& xs) { return VariablePtrList({ F::sin(xs[0]) * xs[1] }); }, { a, b });
+			} },
+			{ "1M: sum(axis=ROW)", [&]() {
+				return utils::gradient_check("1M: sum(axis=ROW)", [](const VariablePtrList& xs) { return VariablePtrList({ F::sum(xs[0], nc::Axis::ROW) }); }, { x });
+			} },
+		});
+		for (const auto& c : cases) {
+			auto r = timed(c.second, seconds);
+			print_result(r, seconds);
+			all_passed = all_passed && r.passed;
+		}
+	}
+
+	std::printf("%s\n", all_passed ? "all passed" : "FAILED");
+	return all_passed;
+}
+
+}
@@ -0,0 +1,117 @@
+#include "pch.h"
+
+#include "../dezero/dezero.hpp"
+
+using namespace dz;
+using namespace dz::models;
+namespace F = functions;
+namespace O = optimizers;
+
+namespace check_parallel_seed {
+
+// wKʁieXebv̑ƁAwK̃p[^̒lj
+struct Result
+{
+	std::vector<data_t> losses;
+	std::vector<data_t> params;
+};
+
+// fPwK
+// d݂̏l UsingSeed ŗ^V[h猈܂
+Result train(uint64_t seed, const std::vector<int>& sizes, const NdArray& x_data, const NdArray& t_data, int iters)
+{
+	UsingSeed with(seed);
+	auto model = std::make_shared<MLP>(sizes);
+	auto optimizer = O::MomentumSGD(0.2);
+	optimizer.setup(model);
+	auto x = as_variable(as_array(x_data));
+	auto t = as_variable(as_array(t_data));
+
+	auto result = Result();
+	for (int i = 0; i < iters; i++) {
+		auto loss = F::mean_squared_error((*model)(x)[0], t);
+		model->cleargrads();
+		loss->backward();
+		optimizer.update();
+		result.losses.push_back((*loss->data)[0]);
+	}
+	// params() ͏WŃAhXɕԂ߁AlŕבւĂAisƂɏςȂ悤Ɂj
+	auto values = std::vector<std::vector<data_t>>();
+	for (const auto& p : model->params()) {
+		values.emplace_back(p->data->begin(), p->data->end());
+	}
+	std::sort(values.begin(), values.end());
+	for (const auto& v : values) {
+		result.params.insert(result.params.end(), v.begin(), v.end());
+	}
+	return result;
+}
+
+// rbgPʂňv邩
+bool bit_equal(const std::vector<data_t>& a, const std::vector<data_t>& b)
+{
+	return a.size() == b.size() && std::memcmp(a.data(), b.data(), sizeof(data_t) * a.size()) == 0;
+}
+
+// wK̍Č̊mF
+// N  MLP ꂼʂ̃V[h N ̃XbhœɊwKA
+// ef̑̐ڂƊwK̃p[^AV[hłPɊwKʂƃrbgPʂňv邩mF
+// 傫fł́AeXbh̉ZJ[lL̃Xbhv[g
+// SĈv true Ԃ
+bool check_parallel_seed()
+{
+	const int num_models = 8;
+	const int rounds = 3;
+
+	struct Case
+	{
+		const char* name;
+		std::vector<int> sizes;
+		uint32_t batch;
+		uint32_t features;
+		int iters;
+	};
+	auto cases = std::vector<Case>({
+		{ "step46 MLP {10, 1}", { 10, 1 }, 100, 1, 200 },
+		{ "MLP {256, 256, 1}", { 256, 256, 1 }, 256, 64, 10 },
+	});
+
+	bool all_ok = true;
+	for (const auto& c : cases) {
+		nc::random::seed(0);
+		auto x_data = nc::random::rand<data_t>({ c.batch, c.features });
+		auto t_data = nc::random::rand<data_t>({ c.batch, 1 });
+
+		// ɊwK
+		auto expected = std::vector<Result>();
+		for (int i = 0; i < num_models; i++) {
+			expected.push_back(train(i, c.sizes, x_data, t_data, c.iters));
+		}
+
+		std::printf("%s, %d models x %d threads, %d iterations\n", c.name, num_models, num_models, c.iters);
+		std::printf("  %-6s %-8s %12s\n", "round", "result", "mismatches");
+		for (int round = 0; round < rounds; round++) {
+			auto results = std::vector<Result>(num_models);
+			auto threads = std::vector<std::thread>();
+			for (int i = 0; i < num_models; i++) {
+				threads.emplace_back([&, i]() { results[i] = train(i, c.sizes, x_data, t_data, c.iters); });
+			}
+			for (auto& th : threads) {
+				th.join();
+			}
+
+			int mismatches = 0;
+			for (int i = 0; i < num_models; i++) {
+				if (!bit_equal(results[i].losses, expected[i].losses) || !bit_equal(results[i].params, expected[i].params)) {
+					mismatches++;
+				}
+			}
+			all_ok = all_ok && mismatches == 0;
+			std::printf("  %-6d %-8s %12d\n", round, mismatches == 0 ? "OK" : "NG", mismatches);
+		}
+	}
+	std::printf("%s\n", all_ok ? "all models match" : "MISMATCH");
+	return all_ok;
+}
+
+}
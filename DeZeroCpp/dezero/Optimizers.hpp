@@ -29,9 +29,10 @@ public:
 		this->target = target;
 		return *this;
 	}
+	// |C^œnC͌ĂяoL邽߁AOptimizer ͉ȂiX^bÑCn悤Ɂj
 	Optimizer& setup(L::Layer* target)
 	{
-		return this->setup(L::LayerPtr(target));
+		return this->setup(L::LayerPtr(target, [](L::Layer*) {}));
 	}
 
 	// XV
@@ -78,7 +79,7 @@ public:
 	void update_one(const VariablePtr& param) override
 	{
 		// zɊwKWZlŃp[^XV
-		*(param->data) -= this->lr * *(param->grad->data);
+		expr::ref(*param->data) -= this->lr * expr::ref(*param->grad->data);
 	}
 };
 
@@ -107,10 +108,10 @@ public:
 		}
 
 		// p[^XV
-		auto v = this->vs[v_key];
-		*v *= this->momentum;
-		*v -= this->lr * *param->grad->data;
-		*param->data += *v;
+		// ev[gňꎞIuWFNg𐶐ɕ]
+		auto v = expr::ref(*this->vs[v_key]);
+		v = this->momentum * v - this->lr * expr::ref(*param->grad->data);
+		expr::ref(*param->data) += v;
 	}
 };
 
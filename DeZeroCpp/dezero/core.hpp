@@ -18,17 +18,88 @@ class Function;
 using data_t = double;	// TODO: ŏIIɂ float ɂ
 using NdArray = nc::NdArray<data_t>;
 
+// vZOt̃m[hiVariable/Functionj̃X}[g|C^N^̎QƃJEgɂ
+// m[h̐EjƂ̊ǗubN̊mۂƁAQƃJEg̊ԐڎQƂȂ
+//#define DEZERO_INTRUSIVE_REF
+
 // X}[g|C^^
 using NdArrayPtr = std::shared_ptr<NdArray>;
+#ifdef DEZERO_INTRUSIVE_REF
+using VariablePtr = Ref<Variable>;
+using VariableWPtr = WeakRef<Variable>;
+using ParameterPtr = Ref<Parameter>;
+using FunctionPtr = Ref<Function>;
+
+// m[h̊NX
+template<typename T>
+using NodeBase = EnableRefFromThis<T>;
+#else
 using VariablePtr = std::shared_ptr<Variable>;
 using VariableWPtr = std::weak_ptr<Variable>;
 using ParameterPtr = std::shared_ptr<Parameter>;
 using FunctionPtr = std::shared_ptr<Function>;
 
+// m[h̊NX
+template<typename T>
+using NodeBase = std::enable_shared_from_this<T>;
+#endif	// #ifdef DEZERO_INTRUSIVE_REF
+
+// m[h̐iVariablePtr/FunctionPtr Ȃǂ̃X}[g|C^^ɍ킹j
+template<typename T, typename... Args>
+inline auto make_node(Args&&... args)
+{
+#ifdef DEZERO_INTRUSIVE_REF
+	return make_ref<T>(std::forward<Args>(args)...);
+#else
+	return std::make_shared<T>(std::forward<Args>(args)...);
+#endif	// #ifdef DEZERO_INTRUSIVE_REF
+}
+
+// m[h̓ILXg
+template<typename T, typename U>
+inline auto node_cast(const U& p)
+{
+	using std::dynamic_pointer_cast;
+	return dynamic_pointer_cast<T>(p);
+}
+
 // Xg^
-using NdArrayPtrList = std::vector<NdArrayPtr>;
-using VariablePtrList = std::vector<VariablePtr>;
-using VariableWPtrList = std::vector<VariableWPtr>;
+// ֐̓o͂͂قƂǂRȉ̂߁A͈̔͂ł̓q[vmۂȂ SmallVector g
+constexpr size_t list_inline_size = 3;
+using NdArrayPtrList = SmallVector<NdArrayPtr, list_inline_size>;
+using VariablePtrList = SmallVector<VariablePtr, list_inline_size>;
+using VariableWPtrList = SmallVector<VariableWPtr, list_inline_size>;
+
+// obt@v[mۂ̈g NdArrayPtr 𐶐
+// NdArray ͗̈LȂ`ŐANdArrayPtr ̔jɗ̈v[֕ԋp
+inline NdArrayPtr pooled_array(const nc::Shape& shape)
+{
+	auto bytes = sizeof(data_t) * shape.size();
+	auto p = static_cast<data_t*>(memory::BufferPool::get_instance().allocate(bytes));
+	auto deleter = [p, bytes](NdArray* a) {
+		delete a;
+		memory::BufferPool::get_instance().deallocate(p, bytes);
+	};
+	return NdArrayPtr(new NdArray(p, shape.rows, shape.cols, false), deleter);
+}
+
+// vf1 NdArrayPtr 𐶐
+// l NdArray ǗubNƓ̈ɒuAmۂPɂ܂Ƃ߂ipooled_array ł͗̈ENdArrayEǗubN̂Rj
+inline NdArrayPtr scalar_array(data_t value)
+{
+	struct Storage
+	{
+		data_t value;
+		NdArray array;
+
+		Storage(data_t value) : value(value), array(&this->value, 1, 1, false) {}
+		// array g value QƂ邽߃Rs[s
+		Storage(const Storage&) = delete;
+		Storage& operator=(const Storage&) = delete;
+	};
+	auto storage = std::make_shared<Storage>(value);
+	return NdArrayPtr(storage, &storage->array);
+}
 
 // NdArrayPtr֐
 inline NdArrayPtr as_array(nullptr_t /*=nullptr*/)
@@ -37,7 +108,12 @@ inline NdArrayPtr as_array(nullptr_t /*=nullptr*/)
 }
 inline NdArrayPtr as_array(std::initializer_list<NdArray::value_type> list)
 {
-	return std::make_shared<NdArray>(list);
+	if (list.size() == 1) {
+		return scalar_array(*list.begin());
+	}
+	auto a = pooled_array({ 1, static_cast<uint32_t>(list.size()) });
+	std::copy(list.begin(), list.end(), a->begin());
+	return a;
 }
 inline NdArrayPtr as_array(NdArray::value_type scalar)
 {
@@ -45,7 +121,48 @@ inline NdArrayPtr as_array(NdArray::value_type scalar)
 }
 inline NdArrayPtr as_array(const NdArray& data)
 {
-	return std::make_shared<NdArray>(data);
+	//  NdArray ̓v[gȂ
+	if (data.size() == 0) {
+		return std::make_shared<NdArray>(data);
+	}
+	auto a = pooled_array(data.shape());
+	std::copy(data.begin(), data.end(), a->begin());
+	return a;
+}
+
+// XJ[ivf1jł邩
+inline bool is_scalar(const NdArray& a)
+{
+	return a.size() == 1;
+}
+
+// vfƂ̉ZiPj
+// vfꍇ̓Xbhv[ŕČvZ
+template<typename F>
+inline NdArrayPtr map_array(const NdArray& x, F f)
+{
+	auto y = pooled_array(x.shape());
+	auto px = x.data();
+	auto py = y->data();
+	parallel::parallel_for(0, x.size(), parallel::default_grain, [px, py, f](size_t first, size_t last) {
+		for (auto i = first; i < last; i++) py[i] = f(px[i]);
+	});
+	return y;
+}
+// vfƂ̉Zi񍀁j
+// ̓f[^͓`ł邱Ɓiu[hLXg͌Ăяoōsj
+template<typename F>
+inline NdArrayPtr map_array(const NdArray& x0, const NdArray& x1, F f)
+{
+	assert(x0.shape() == x1.shape());
+	auto y = pooled_array(x0.shape());
+	auto px0 = x0.data();
+	auto px1 = x1.data();
+	auto py = y->data();
+	parallel::parallel_for(0, x0.size(), parallel::default_grain, [px0, px1, py, f](size_t first, size_t last) {
+		for (auto i = first; i < last; i++) py[i] = f(px0[i], px1[i]);
+	});
+	return y;
 }
 
 // VariablePtr֐
@@ -55,11 +172,11 @@ inline VariablePtr as_variable(nullptr_t = nullptr)
 }
 inline VariablePtr as_variable(const NdArrayPtr& data, const std::string& name = "")
 {
-	return std::make_shared<Variable>(data, name);
+	return make_node<Variable>(data, name);
 }
 inline VariablePtr as_variable(const Variable& data)
 {
-	return std::make_shared<Variable>(data);
+	return make_node<Variable>(data);
 }
 
 //----------------------------------
@@ -69,6 +186,12 @@ extern inline VariablePtr add(const VariablePtr& x0, const VariablePtr& x1);
 extern inline VariablePtr sub(const VariablePtr& x0, const VariablePtr& x1);
 extern inline VariablePtr mul(const VariablePtr& x0, const VariablePtr& x1);
 extern inline VariablePtr div(const VariablePtr& x0, const VariablePtr& x1);
+extern inline VariablePtr add(const VariablePtr& x, data_t c);
+extern inline VariablePtr sub(const VariablePtr& x, data_t c);
+extern inline VariablePtr rsub(const VariablePtr& x, data_t c);
+extern inline VariablePtr mul(const VariablePtr& x, data_t c);
+extern inline VariablePtr div(const VariablePtr& x, data_t c);
+extern inline VariablePtr rdiv(const VariablePtr& x, data_t c);
 extern inline VariablePtr pos(const VariablePtr& x);
 extern inline VariablePtr neg(const VariablePtr& x);
 extern inline VariablePtr power(const VariablePtr& x0, uint32_t c);
@@ -143,6 +266,8 @@ extern std::string replace_all(const std::string& target_str, const std::string&
 extern inline NdArray broadcast_to(const NdArray& in_array, const nc::Shape& shape);
 extern inline NdArray sum_to(const NdArray& in_array, const nc::Shape& shape);
 extern inline void broadcast_mutual(NdArray& a0, NdArray& a1);
+extern inline NdArray sum(const NdArray& in_array, nc::Axis axis);
+extern inline NdArray dot(const NdArray& a, const NdArray& b);
 
 extern inline void plot_dot_graph(const VariablePtr& output, bool verbose = true, const std::string& to_file = "graph.png");
 }	// namespace utils
@@ -152,18 +277,72 @@ extern inline void plot_dot_graph(const VariablePtr& output, bool verbose = true
 //----------------------------------
 
 // ݒNX
+// ݒl param ŖO邪A`dEt`d̂тɎQƂl flags Ɏʂ̂gił̌邽߁j
+// @param 𒼐ڏꍇ sync ĂԂƁiUsingConfig Ȃǂ̐ݒύXNX set ͎ŌĂԁj
 class Config
 {
+public:
+	// ݒl̎ʂ
+	struct Flags
+	{
+		bool enable_backprop = true;
+		bool release_data = false;
+		bool parallel_backward = false;
+		bool deterministic_backward = true;
+		bool per_sample_grad = false;
+	};
+
 private:
 	// RXgN^
 	Config() {
 		// t`d
 		param["enable_backprop"] = true;
+		// t`dŎgȂԃf[^A[ŨR[hQƂȂȂ_ŉ邩i`dEt`d̓rŉj
+		param["release_data"] = false;
+		// t`dɎs邩
+		param["parallel_backward"] = false;
+		// ̋t`dŌz̉ZŒ肷邩iʂsɈˑȂȂj
+		param["deterministic_backward"] = true;
+		// t`dŃp[^̃TvƂ̌z߂邩
+		param["per_sample_grad"] = false;
+
+		this->sync();
 	}
 
 public:
 	// ݒl
 	std::unordered_map<std::string, bool> param;
+	// ݒl̎ʂ
+	Flags flags;
+
+	// ݒlύX
+	// ʂ͕ύXݒ̕XVit`d̂тɌĂ΂邽ߑŜǂݒȂj
+	void set(const std::string& name, bool value)
+	{
+		this->param[name] = value;
+		if (auto flag = this->find_flag(name)) *flag = value;
+	}
+
+	// ݒ薼ɑΉʂiʂȂݒ nullptrj
+	bool* find_flag(const std::string& name)
+	{
+		if (name == "enable_backprop") return &this->flags.enable_backprop;
+		if (name == "release_data") return &this->flags.release_data;
+		if (name == "parallel_backward") return &this->flags.parallel_backward;
+		if (name == "deterministic_backward") return &this->flags.deterministic_backward;
+		if (name == "per_sample_grad") return &this->flags.per_sample_grad;
+		return nullptr;
+	}
+
+	// ݒl̎ʂ param ɍ킹
+	void sync()
+	{
+		this->flags.enable_backprop = this->param["enable_backprop"];
+		this->flags.release_data = this->param["release_data"];
+		this->flags.parallel_backward = this->param["parallel_backward"];
+		this->flags.deterministic_backward = this->param["deterministic_backward"];
+		this->flags.per_sample_grad = this->param["per_sample_grad"];
+	}
 
 	// Rs[/[us
 	Config(const Config&) = delete;
@@ -172,8 +351,9 @@ public:
 	Config& operator=(Config&&) = delete;
 
 	// CX^X擾
+	// ݒ̓XbhƂɎiXbh no_grad ̃XbhɉeȂ悤Ɂj
 	static Config& get_instance() {
-		static Config instance;
+		static thread_local Config instance;
 		return instance;
 	}
 };
@@ -193,13 +373,13 @@ public:
 	{
 		// ݒύX
 		old_value = Config::get_instance().param[name];
-		Config::get_instance().param[name] = value;
+		Config::get_instance().set(name, value);
 	}
 	// fXgN^
 	virtual ~UsingConfig()
 	{
 		// ݒ蕜
-		Config::get_instance().param[name] = old_value;
+		Config::get_instance().set(name, old_value);
 	}
 
 	// Rs[/[us
@@ -215,6 +395,144 @@ struct no_grad : UsingConfig
 	no_grad() : UsingConfig("enable_backprop", false) {}
 };
 
+// Xg[NX
+// p[^̏ȂǂɎgXbhƂɐ
+// V[hݒ肵ĂȂXbhł͏]ǂ nc::random ̋L̏Ԃgir䂠j
+class RandomStream
+{
+private:
+	// GW
+	std::mt19937_64 engine;
+	// V[hݒς݂
+	bool seeded;
+
+	// RXgN^
+	RandomStream() :
+		seeded(false)
+	{}
+
+	// nc::random ̔r
+	static std::mutex& shared_mutex() {
+		static std::mutex mtx;
+		return mtx;
+	}
+
+public:
+	// Rs[/[us
+	RandomStream(const RandomStream&) = delete;
+	RandomStream(RandomStream&&) = delete;
+	RandomStream& operator=(const RandomStream&) = delete;
+	RandomStream& operator=(RandomStream&&) = delete;
+
+	// CX^X擾
+	static RandomStream& get_instance() {
+		static thread_local RandomStream instance;
+		return instance;
+	}
+
+	// V[hݒ
+	void seed(uint64_t seed)
+	{
+		this->engine.seed(seed);
+		this->seeded = true;
+	}
+	// V[hinc::random gԂɖ߂j
+	void unseed()
+	{
+		this->seeded = false;
+	}
+
+	// Ԃ̕ۑ/
+	std::pair<std::mt19937_64, bool> state() const
+	{
+		return { this->engine, this->seeded };
+	}
+	void set_state(const std::pair<std::mt19937_64, bool>& state)
+	{
+		this->engine = state.first;
+		this->seeded = state.second;
+	}
+
+	// WKzɏ]
+	NdArray randn(const nc::Shape& shape)
+	{
+		if (!this->seeded) {
+			std::lock_guard<std::mutex> lock(shared_mutex());
+			return nc::random::randN<data_t>(shape);
+		}
+		auto a = NdArray(shape);
+		auto dist = std::normal_distribution<data_t>();
+		for (auto& v : a) {
+			v = dist(this->engine);
+		}
+		return a;
+	}
+};
+
+// Xg[ꎞύXNX
+// XR[v̊Ԃ݂̃Xbh̗Xg[w̃V[hŏ
+// fƂɕʂ̃V[h^΁Aǂ̃XbhŊwKĂlɂȂ
+class UsingSeed
+{
+private:
+	// ύXȌ
+	std::pair<std::mt19937_64, bool> old_state;
+
+public:
+	// RXgN^
+	UsingSeed(uint64_t seed) :
+		old_state(RandomStream::get_instance().state())
+	{
+		RandomStream::get_instance().seed(seed);
+	}
+	// fXgN^
+	virtual ~UsingSeed()
+	{
+		RandomStream::get_instance().set_state(this->old_state);
+	}
+
+	// Rs[/[us
+	UsingSeed(const UsingSeed&) = delete;
+	UsingSeed(UsingSeed&&) = delete;
+	UsingSeed& operator=(const UsingSeed&) = delete;
+	UsingSeed& operator=(UsingSeed&&) = delete;
+};
+
+// ԃf[^̉NX
+// ֐̏o̓f[^L^ĂAvZOt̊֐̓͂ƂĂQƂĂi[ŨR[hQƂłȂĵ̂A
+// t`dŎgȂ̂̃f[^iConfig  release_data Lȏꍇ Function ̌ĂяoŎgj
+// L^̓XbhƂɎBmF͋L^̐O̊mFŎĉQ{𒴂邽тɍsAL^P̊mF̎Ԃɗ}
+class ReleaseQueue
+{
+private:
+	// L^ϐ
+	std::vector<VariableWPtr> vars;
+	// O̊mFŎc
+	size_t kept = 0;
+
+	// RXgN^
+	ReleaseQueue() {}
+
+public:
+	// Rs[/[us
+	ReleaseQueue(const ReleaseQueue&) = delete;
+	ReleaseQueue(ReleaseQueue&&) = delete;
+	ReleaseQueue& operator=(const ReleaseQueue&) = delete;
+	ReleaseQueue& operator=(ReleaseQueue&&) = delete;
+
+	// L^iL^̐ɉĊmFsj
+	inline void add(const VariablePtr& v);
+
+	// mFiłϐ̃f[^A[ŨR[hQƂĂϐ͋L^Ɏcj
+	inline void collect();
+
+	// ݂̃Xbh̋L^
+	static ReleaseQueue& current() {
+		static thread_local ReleaseQueue queue;
+		return queue;
+	}
+};
+
 // NdArray̏o̓wp[NX
 class NdArrayPrinter
 {
@@ -229,7 +547,7 @@ public:
 };
 
 // ϐNX
-class Variable : public std::enable_shared_from_this<Variable>
+class Variable : public NodeBase<Variable>
 {
 public:
 	// f[^
@@ -238,17 +556,52 @@ public:
 	std::string name;
 	// z
 	VariablePtr grad;
+	// ڐi[h̔lj
+	NdArrayPtr tangent;
 	// ̊֐
 	FunctionPtr creator;
 	// 
 	int generation;
+	// t`dŃf[^KvƂ֐̐
+	// ̋t`dł͕̃[J[邽߃Ag~bNɐ
+	std::atomic<int> data_users;
+	// ͂ƂĕێĂ֐̐i֐ێꍇ͂̉񐔁j
+	// QƂ̐Ƃ̍[ŨR[hȂǌvZOt̊O̎QƂ̐ɂȂiԃf[^̉̔Ɏgj
+	std::atomic<int> graph_refs;
 
 	// RXgN^
 	Variable(const NdArrayPtr& data, const std::string& name = "") :
 		data(data),
 		name(name),
-		generation(0)
+		generation(0),
+		data_users(0),
+		graph_refs(0)
 	{}
+	// Rs[RXgN^
+	// data_users  graph_refs ̓Rs[̌vZOtł̎QƐ̂߈pȂistd::atomic ̓Rs[łȂߖj
+	Variable(const Variable& other) :
+		NodeBase<Variable>(other),
+		data(other.data),
+		name(other.name),
+		grad(other.grad),
+		tangent(other.tangent),
+		creator(other.creator),
+		generation(other.generation),
+		data_users(0),
+		graph_refs(0)
+	{}
+	// Rs[
+	// data_users  graph_refs ͎gQƂvZOt̐Ȃ̂ł̂܂܂ɂ
+	Variable& operator=(const Variable& other) {
+		if (this == &other) return *this;
+		this->data = other.data;
+		this->name = other.name;
+		this->grad = other.grad;
+		this->tangent = other.tangent;
+		this->creator = other.creator;
+		this->generation = other.generation;
+		return *this;
+	}
 
 	// fXgN^
 	virtual ~Variable() {}
@@ -258,12 +611,22 @@ public:
 
 	// t`d(ċA)
 	void backward(bool retain_grad = false, bool create_graph = false);
+	// t`d()
+	void backward_parallel(bool retain_grad = false);
 
 	// z
-	void cleargrad() {
+	virtual void cleargrad() {
 		this->grad = nullptr;
 	}
 
+	// t`dŕKvƂĂȂ΃f[^
+	// `d̓rʂȂǁAȍ~ŎQƂȂƂĂϐɑ΂Ďgp
+	bool release_data() {
+		if (this->data_users > 0) return false;
+		this->data = nullptr;
+		return true;
+	}
+
 	// ̕ʊ֐ֈϏăNX̗֐߂
 	decltype(auto) shape() { return data->shape(); }
 	decltype(auto) size() { return data->size(); }
@@ -276,24 +639,91 @@ public:
 class Parameter : public Variable
 {
 public:
+	// TvƂ̌zisTvA񂪃p[^̗vfɑΉj
+	// Config  per_sample_grad LȏꍇɁAΉ֐̋t`dŐݒ肳
+	NdArrayPtr grad_sample;
+
 	// RXgN^
 	Parameter(const NdArrayPtr& data, const std::string& name = "") :
 		Variable(data, name)
 	{}
+
+	// z
+	void cleargrad() override {
+		Variable::cleargrad();
+		this->grad_sample = nullptr;
+	}
+
+	// TvƂ̌zZ
+	void add_grad_sample(const NdArrayPtr& g)
+	{
+		if (!this->grad_sample) this->grad_sample = g;
+		else this->grad_sample = map_array(*this->grad_sample, *g, [](data_t a, data_t b) { return a + b; });
+	}
 };
 
+// t`dXJ[̂܂܌vZł邩
+// vZOtȂienable_backprop ȁjꍇŁAϐׂăXJ[ڐȂƂ true
+// ֐NX̋t`d́ȀꍇɌz̒l𒼐ڌvZāAr̊֐ƕϐ̐Ȃ
+template<typename... Vs>
+inline bool is_scalar_backward(const Vs&... vs)
+{
+	return !Config::get_instance().flags.enable_backprop && ((vs && vs->data && is_scalar(*vs->data) && !vs->tangent) && ...);
+}
+
+// XJ[̕ϐ̒l
+inline data_t scalar_value(const VariablePtr& v)
+{
+	return (*v->data)[0];
+}
+
+// ԃf[^ŉł邩
+// ̊֐At`dŎgꂸAvZOt̊֐͈̓ȊOQƂĂȂi[ŨR[hQƂłȂjꍇ true
+// local_refs ͌ĂяoꎞIɕێĂQƂ̐
+inline bool can_release(const VariablePtr& v, long local_refs)
+{
+	return v && v->data && v->creator && v->data_users == 0 && static_cast<long>(v.use_count()) == v->graph_refs + local_refs;
+}
+
+// ԃf[^̉NX̋L^
+// Variable ̒`KvȂ߂̈ʒuŒ`
+inline void ReleaseQueue::add(const VariablePtr& v)
+{
+	this->vars.push_back(v);
+	if (this->vars.size() > 2 * this->kept + 1) this->collect();
+}
+
+// ԃf[^̉NX̊mF
+// jς݁Eς݂̕ϐƁAt`dŎgϐ͋L^Oi҂͋t`d̒ŉj
+inline void ReleaseQueue::collect()
+{
+	size_t n = 0;
+	for (size_t i = 0; i < this->vars.size(); i++) {
+		auto v = this->vars[i].lock();
+		if (!v || !v->data || v->data_users > 0) continue;
+		if (can_release(v, 1)) {
+			v->release_data();
+			continue;
+		}
+		if (i != n) this->vars[n] = std::move(this->vars[i]);
+		n++;
+	}
+	this->vars.erase(this->vars.begin() + n, this->vars.end());
+	this->kept = n;
+}
+
 // ParameterPtr֐ (NXVariablePtr^ƂĈ)
 inline VariablePtr as_parameter(const NdArrayPtr& data, const std::string& name = "")
 {
-	return std::make_shared<Parameter>(data, name);
+	return make_node<Parameter>(data, name);
 }
 inline VariablePtr as_parameter(const Parameter& data)
 {
-	return std::make_shared<Parameter>(data);
+	return make_node<Parameter>(data);
 }
 
 // ֐NX
-class Function : public std::enable_shared_from_this<Function>
+class Function : public NodeBase<Function>
 {
 public:
 	// ̓f[^
@@ -302,9 +732,19 @@ public:
 	VariableWPtrList outputs;
 	// 
 	int generation = 0;
+	// `d̊ԂQƂł̓f[^̐ڐ
+	NdArrayPtrList input_tangents;
+	// `d̒ŋ߂o̓f[^̐ڐ
+	// Ƀp[^֐i`FbN|Cgj́A̓f[^ɐڐȂĂ`d̒Őڐ߂Đݒ肷
+	NdArrayPtrList output_tangents;
 
 	// fXgN^
-	virtual ~Function() {}
+	virtual ~Function()
+	{
+		for (const auto& i : this->inputs) {
+			if (i) i->graph_refs--;
+		}
+	}
 
 	// ()Zq
 	VariablePtrList operator()(const NdArrayPtr& input)
@@ -323,39 +763,84 @@ public:
 	// ()Zq
 	VariablePtrList operator()(const VariablePtrList& inputs)
 	{
-		// ̓f[^NdArrayo
+		// ̓f[^NdArrayƐڐo
+		// ڐ͂ꂩ̓̓f[^ꍇoiڐgȂ唼̌ĂяoŃXg̃Rs[Ȃj
 		auto xs = NdArrayPtrList();
+		auto txs = NdArrayPtrList();
+		bool has_tangent = false;
 		for (const auto& i : inputs) {
 			xs.push_back(i->data);
+			if (i->tangent) has_tangent = true;
+		}
+		if (has_tangent) {
+			for (const auto& i : inputs) {
+				txs.push_back(i->tangent);
+			}
 		}
 
 		// `d
+		if (has_tangent) this->input_tangents = txs;
 		auto ys = this->forward(xs);
+		auto tys = NdArrayPtrList();
+		std::swap(tys, this->output_tangents);
+		this->input_tangents.clear();
+
+		// t`d\̏ꍇA̓f[^̂ől̐g̐Ƃ
+		// o̓f[^̐͐̊֐̐ォ猈܂邽߁Ao̓f[^̍쐬Oɋ߂
+		if (Config::get_instance().flags.enable_backprop) {
+			auto max_elem = std::max_element(
+				inputs.cbegin(), inputs.cend(),
+				[](const VariablePtr& lhs, const VariablePtr& rhs) { return lhs->generation < rhs->generation; }
+			);
+			this->generation = (*max_elem)->generation;
+		}
 
 		// vZʂo̓f[^쐬
+		// `d͐VCX^XԂ܂Ȃ̂ŃRs[ɂ̂܂܎g
 		auto outputs = VariablePtrList();
 		for (const auto& y : ys) {
-			auto o = as_variable(as_array(*y));
+			auto o = as_variable(y);
 			o->set_creator(shared_from_this());
 			outputs.push_back(o);
 		}
 
-		// t`d\̏ꍇ
-		if (Config::get_instance().param["enable_backprop"]) {
-			// ̓f[^̂ől̐g̐Ƃ
-			auto max_elem = std::max_element(
-				inputs.cbegin(), inputs.cend(),
-				[](VariablePtr lhs, VariablePtr rhs) { return lhs->generation < rhs->generation; }
-			);
-			this->generation = (*max_elem)->generation;
+		// ̓f[^ڐꍇ͏o̓f[^̐ڐ߂i[h̔j
+		// t`d̒ŌĂ΂ꂽꍇlȂ̂ŁAz̐ڐiz̕j
+		if (tys.empty() && has_tangent) {
+			tys = this->jvp(xs, ys, txs);
+		}
+		if (!tys.empty()) {
+			for (size_t k = 0; k < outputs.size() && k < tys.size(); k++) {
+				auto t = tys[k];
+				// u[hLXgꂽo͂͐ڐo͂̌`ɍ킹
+				if (t && t->shape() != outputs[k]->data->shape()) {
+					t = as_array(utils::broadcast_to(*t, outputs[k]->data->shape()));
+				}
+				outputs[k]->tangent = t;
+			}
+		}
 
+		// t`d\̏ꍇ
+		if (Config::get_instance().flags.enable_backprop) {
 			// o̓f[^ێ
 			this->inputs = inputs;
+			for (const auto& i : this->inputs) {
+				if (i) i->graph_refs++;
+			}
 			this->outputs = VariableWPtrList();
 			for (const auto& o : outputs) {
 				VariableWPtr w = o;
 				this->outputs.push_back(w);
 			}
+
+			// t`dŎgpf[^̗pҐ𐔂
+			this->add_data_users(1);
+
+			// ԃf[^ݒȂAo̓f[^L^ĕsvɂȂ̂
+			if (Config::get_instance().flags.release_data) {
+				auto& queue = ReleaseQueue::current();
+				for (const auto& o : outputs) queue.add(o);
+			}
 		}
 
 		return outputs;
@@ -365,6 +850,33 @@ public:
 	virtual NdArrayPtrList forward(const NdArrayPtrList& xs) = 0;
 	// t`d
 	virtual VariablePtrList backward(const VariablePtrList& gy) = 0;
+	// [h̔i̓f[^̐ڐ txs o̓f[^̐ڐ߂j
+	// ڐ nullptr ̓͂̓[ƂĈ
+	virtual NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& /*txs*/)
+	{
+		// Ή̊֐
+		throw std::logic_error("jvp is not implemented for this function");
+	}
+
+	// t`dœ̓f[^̒lgp邩
+	virtual bool need_inputs() const { return true; }
+	// t`dŏo̓f[^̒lgp邩
+	virtual bool need_outputs() const { return true; }
+
+	// t`dŎgpo̓f[^̗pҐ𑝌
+	void add_data_users(int n)
+	{
+		if (this->need_inputs()) {
+			for (const auto& i : this->inputs) {
+				if (i) i->data_users += n;
+			}
+		}
+		if (this->need_outputs()) {
+			for (const auto& o : this->outputs) {
+				if (auto y = o.lock()) y->data_users += n;
+			}
+		}
+	}
 };
 
 // ̊֐ݒ
@@ -387,25 +899,53 @@ inline void Variable::backward(bool retain_grad /*=false*/, bool create_graph /*
 		this->grad = as_variable(as_array(g));
 	}
 
-	// ֐Xg
-	auto funcs = std::list<FunctionPtr>();
+	// sLȂłŏ
+	// vZOtꍇ́AVȃOt̍\zȂ悤ŏ
+	// Xbhv[̃^XN̒i̋t`d̒ Checkpoint ČvZ̋t`dȂǁjŏ
+	// @q̕łҋ@ɊÕ[J[sƁÃ[J[X^bN̉ŒfĂ֐̊҂邽
+	if (Config::get_instance().flags.parallel_backward && !create_graph && !parallel::ThreadPool::in_task()) {
+		this->backward_parallel(retain_grad);
+		return;
+	}
+
+	// ֐Xgȉj
+	auto funcs = std::vector<FunctionPtr>();
 	// ς݊֐Zbg
-	auto seen_set = std::set<FunctionPtr>();
+	auto seen_set = std::unordered_set<const Function*>();
 
 	// N[WF֐Xg֒ǉ
 	auto add_func = [&funcs, &seen_set](const FunctionPtr& f) {
 		// Xg֖ǉ̊֐Ȃ
-		if (seen_set.find(f) == seen_set.end()) {
-			// Xg֒ǉĐŏ\[g
-			funcs.push_back(f);
-			seen_set.insert(f);
-			funcs.sort([](const FunctionPtr& lhs, const FunctionPtr& rhs) { return lhs->generation < rhs->generation; });
+		if (seen_set.insert(f.get()).second) {
+			// ̏ۂʒui̊֐̌j֑}
+			// ǉ̂тɑŜ\[gȂB̊֐̏͒ǉ̂܂܁i]̈\[gƓj
+			auto pos = std::upper_bound(
+				funcs.begin(), funcs.end(), f->generation,
+				[](int generation, const FunctionPtr& g) { return generation < g->generation; }
+			);
+			funcs.insert(pos, f);
 		}
 	};
 
 	// ŏ̊֐Xgɒǉ
 	add_func(this->creator);
 
+	// ԃf[^邩ivZOtꍇ͉Ȃj
+	bool release_data = Config::get_instance().flags.release_data && !create_graph;
+
+	// N[WFsvɂȂԃf[^
+	// ̊֐Ȃϐi͂p[^jƋt`d̋N_A[ŨR[hQƂĂϐ͑ΏۊO
+	// @local_refs ͌ĂяoꎞIɕێĂQƂ̐
+	auto release = [this](const VariablePtr& v, long local_refs) {
+		if (v.get() != this && can_release(v, local_refs)) {
+			v->release_data();
+		}
+	};
+
+	// [v̊ԂݒύX
+	// ֐ƂɕύXƐݒ̌֐̐邽߁A[vŜłPɂ
+	UsingConfig with("enable_backprop", create_graph);
+
 	// ֐XgɂȂ܂Ń[v
 	while (!funcs.empty()) {
 		// Xg֐o
@@ -419,9 +959,6 @@ inline void Variable::backward(bool retain_grad /*=false*/, bool create_graph /*
 		}
 
 		{
-			// ̃XR[v̒ݒύX
-			UsingConfig with("enable_backprop", create_graph);
-
 			// t`d
 			auto gxs = f->backward(gys);
 
@@ -438,6 +975,10 @@ inline void Variable::backward(bool retain_grad /*=false*/, bool create_graph /*
 					x->grad = gx;
 				}
 				// zݒς݂ȂZ
+				// vZOtȂXJ[m̏ꍇ́AZ̊֐ɒڌvZ
+				else if (is_scalar_backward(x->grad, gx)) {
+					x->grad = as_variable(as_array(scalar_value(x->grad) + scalar_value(gx)));
+				}
 				else {
 					// VCX^X邱Ƃdv
 					// Ⴆ΁Ax->grad += gx; ƂĂ͂Ȃit^AQƁj
@@ -458,9 +999,283 @@ inline void Variable::backward(bool retain_grad /*=false*/, bool create_graph /*
 				y.lock()->grad = nullptr;
 			}
 		}
+
+		// ̊֐̋t`dς񂾂̂ŁAo̓f[^̗p҂Oĉ݂
+		if (release_data) {
+			f->add_data_users(-1);
+			for (const auto& x : f->inputs) {
+				release(x, 0);
+			}
+			for (const auto& y : f->outputs) {
+				release(y.lock(), 1);
+			}
+		}
 	}
 }
 
+// t`dij
+// o͑̌zׂđ֐珇ɁAXbhv[̃[J[ŎoĎs
+// deterministic_backward Lȏꍇ́AzvZOt̏ŉZ邽ߌʂsɈˑȂ
+// ԃf[^̉irelease_dataj͊֐̋t`dςނƂɍsi͔r̒ōsj
+inline void Variable::backward_parallel(bool retain_grad /*=false*/)
+{
+	// zݒ聁t`d̊Jn_
+	if (!this->grad) {
+		auto g = nc::ones_like<data_t>(*this->data);
+		this->grad = as_variable(as_array(g));
+	}
+	if (!this->creator) return;
+
+	// vZOt̊֐
+	struct Node
+	{
+		FunctionPtr f;
+		// o͂̌z܂ĂȂ̊֐̐
+		std::atomic<int> pending{ 0 };
+	};
+	// ϐƂ̌z̏Wv
+	struct Grad
+	{
+		size_t func_index;
+		size_t input_index;
+		VariablePtr gx;
+	};
+	struct Slot
+	{
+		VariablePtr x;
+		std::mutex mtx;
+		std::vector<Grad> gxs;
+	};
+
+	bool deterministic = Config::get_instance().flags.deterministic_backward;
+	// ԃf[^邩
+	bool release_data = Config::get_instance().flags.release_data;
+	std::mutex release_mtx;
+	// Ăяo̐ݒi[J[Xbhֈpj
+	auto params = Config::get_instance().param;
+	params["enable_backprop"] = false;
+
+	// vZOtǂĊ֐ƕϐ񋓁i֐̔Z̃L[Ƃj
+	auto nodes = std::deque<Node>();
+	auto index = std::unordered_map<Function*, size_t>();
+	auto slots = std::unordered_map<Variable*, std::unique_ptr<Slot>>();
+	auto stack = std::vector<Function*>();
+	auto add_node = [&](const FunctionPtr& f) {
+		if (index.find(f.get()) != index.end()) return;
+		index[f.get()] = nodes.size();
+		nodes.emplace_back();
+		nodes.back().f = f;
+		stack.push_back(f.get());
+	};
+	add_node(this->creator);
+	while (!stack.empty()) {
+		auto f = stack.back();
+		stack.pop_back();
+		for (const auto& x : f->inputs) {
+			if (slots.find(x.get()) == slots.end()) {
+				slots[x.get()] = std::make_unique<Slot>();
+				slots[x.get()]->x = x;
+			}
+			if (x->creator) add_node(x->creator);
+		}
+	}
+	for (auto& n : nodes) {
+		for (const auto& x : n.f->inputs) {
+			if (x->creator) nodes[index[x->creator.get()]].pending++;
+		}
+	}
+
+	// N[WFW߂zL[̏ɉZ
+	auto finalize = [](Slot& s) {
+		std::sort(s.gxs.begin(), s.gxs.end(), [](const Grad& lhs, const Grad& rhs) {
+			return std::make_pair(lhs.func_index, lhs.input_index) < std::make_pair(rhs.func_index, rhs.input_index);
+		});
+		for (const auto& g : s.gxs) {
+			s.x->grad = s.x->grad ? s.x->grad + g.gx : g.gx;
+		}
+		s.gxs.clear();
+	};
+
+	// s\ɂȂ֐io͑̌zׂđ֐j
+	auto ready = std::vector<size_t>({ 0 });
+	size_t done = 0;
+	bool aborted = false;
+	std::mutex ready_mtx;
+	std::condition_variable ready_cv;
+
+	// N[WF֐̋t`dsAs\ɂȂ֐Ԃ
+	auto process = [&](size_t k) {
+		const auto& f = nodes[k].f;
+		auto next = std::vector<size_t>();
+
+		// o̓f[^zoċt`d
+		auto gys = VariablePtrList();
+		for (const auto& o : f->outputs) {
+			gys.push_back(o.lock()->grad);
+		}
+		auto gxs = f->backward(gys);
+		assert(f->inputs.size() == gxs.size());
+
+		for (size_t i = 0; i < gxs.size(); i++) {
+			const auto& x = f->inputs[i];
+			auto& s = *slots.at(x.get());
+			{
+				std::lock_guard<std::mutex> lock(s.mtx);
+				if (deterministic) s.gxs.push_back({ k, i, gxs[i] });
+				else x->grad = x->grad ? x->grad + gxs[i] : gxs[i];
+			}
+
+			// ̊֐̏o͑̌zׂđs
+			if (x->creator) {
+				auto c = index.at(x->creator.get());
+				if (--nodes[c].pending == 0) {
+					if (deterministic) {
+						for (const auto& o : nodes[c].f->outputs) {
+							auto it = slots.find(o.lock().get());
+							if (it != slots.end()) finalize(*it->second);
+						}
+					}
+					next.push_back(c);
+				}
+			}
+		}
+
+		// zێȂꍇ
+		if (!retain_grad) {
+			for (const auto& y : f->outputs) {
+				y.lock()->grad = nullptr;
+			}
+		}
+
+		// ̊֐̋t`dς񂾂̂ŁAo̓f[^̗p҂Oĉ݂
+		// ̊֐Ȃϐi͂p[^jƋt`d̋N_A[ŨR[hQƂĂϐ͑ΏۊO
+		// @z̊i[islotsjێĂQƂ͌vZOt̊O̎QƂɐȂ
+		if (release_data) {
+			std::lock_guard<std::mutex> lock(release_mtx);
+			f->add_data_users(-1);
+			auto release = [&](const VariablePtr& v, long local_refs) {
+				if (!v || v.get() == this) return;
+				if (slots.find(v.get()) != slots.end()) local_refs++;
+				if (can_release(v, local_refs)) v->release_data();
+			};
+			for (const auto& x : f->inputs) {
+				release(x, 0);
+			}
+			for (const auto& o : f->outputs) {
+				release(o.lock(), 1);
+			}
+		}
+		return next;
+	};
+
+	// N[WF[J[̏
+	// s\Ȋ֐oď邱ƂAׂĂ̊֐ςނ܂ŌJԂ
+	// Ăяo̐ݒ̓Kp̓[J[ƂɂP񂾂sAIɖ߂
+	auto work = [&]() {
+		struct ScopedParams
+		{
+			std::unordered_map<std::string, bool> old_param;
+			ScopedParams(const std::unordered_map<std::string, bool>& param) :
+				old_param(Config::get_instance().param)
+			{
+				Config::get_instance().param = param;
+				Config::get_instance().sync();
+			}
+			~ScopedParams()
+			{
+				Config::get_instance().param = old_param;
+				Config::get_instance().sync();
+			}
+		} with(params);
+
+		while (true) {
+			size_t k;
+			{
+				std::unique_lock<std::mutex> lock(ready_mtx);
+				ready_cv.wait(lock, [&]() { return !ready.empty() || done == nodes.size() || aborted; });
+				if (ready.empty()) return;
+				k = ready.back();
+				ready.pop_back();
+			}
+
+			auto next = std::vector<size_t>();
+			try {
+				next = process(k);
+			}
+			catch (...) {
+				// ̃[J[҂Ȃ悤fʒm
+				std::lock_guard<std::mutex> lock(ready_mtx);
+				aborted = true;
+				ready.clear();
+				ready_cv.notify_all();
+				throw;
+			}
+
+			std::lock_guard<std::mutex> lock(ready_mtx);
+			if (aborted) return;
+			ready.insert(ready.end(), next.begin(), next.end());
+			if (++done == nodes.size() || next.size() > 1) ready_cv.notify_all();
+			else if (next.size() == 1) ready_cv.notify_one();
+		}
+	};
+
+	// [J[ĂяõXbh܂߂ĕ񏈗ɎgXbh
+	auto& pool = parallel::ThreadPool::get_instance();
+	auto workers = std::min({ parallel::num_threads(), pool.size() + 1, nodes.size() });
+	parallel::TaskGroup group(pool);
+	for (size_t i = 1; i < workers; i++) {
+		group.run(work);
+	}
+	// OŔꍇAO[v̔jɑ̃[J[̏I҂
+	{
+		parallel::ThreadPool::ScopedTask scope;
+		work();
+	}
+	group.wait();
+
+	// ̊֐Ȃϐi͂p[^ǰzm
+	if (deterministic) {
+		UsingConfig with("enable_backprop", false);
+		for (auto& kv : slots) {
+			if (!kv.second->x->creator) finalize(*kv.second);
+		}
+	}
+}
+
+// u[hLXgt̗vfƂ̉Zi񍀁j
+template<typename F>
+inline NdArrayPtr broadcast_map(const NdArray& x0, const NdArray& x1, F f)
+{
+	if (x0.shape() == x1.shape()) return map_array(x0, x1, f);
+	auto a0 = x0;
+	auto a1 = x1;
+	utils::broadcast_mutual(a0, a1);
+	return map_array(a0, a1, f);
+}
+
+// ڐ̌vZpwp[inullptr ̐ڐ̓[ƂĈj
+inline NdArrayPtr tangent_add(const NdArrayPtr& t0, const NdArrayPtr& t1)
+{
+	if (!t0) return t1;
+	if (!t1) return t0;
+	return broadcast_map(*t0, *t1, [](data_t a, data_t b) { return a + b; });
+}
+inline NdArrayPtr tangent_mul(const NdArrayPtr& t, const NdArray& x)
+{
+	if (!t) return nullptr;
+	return broadcast_map(*t, x, [](data_t a, data_t b) { return a * b; });
+}
+inline NdArrayPtr tangent_div(const NdArrayPtr& t, const NdArray& x)
+{
+	if (!t) return nullptr;
+	return broadcast_map(*t, x, [](data_t a, data_t b) { return a / b; });
+}
+inline NdArrayPtr tangent_scale(const NdArrayPtr& t, data_t c)
+{
+	if (!t) return nullptr;
+	return map_array(*t, [c](data_t a) { return a * c; });
+}
+
 // ֐NXiZj
 class Add : public Function
 {
@@ -469,9 +1284,20 @@ public:
 	nc::Shape x0_shape;
 	nc::Shape x1_shape;
 
+	// t`dœo̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+	bool need_outputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
+		// XJ[m̏ꍇ̓u[hLXgȂĒڌvZ
+		if (is_scalar(*xs[0]) && is_scalar(*xs[1])) {
+			x0_shape = xs[0]->shape();
+			x1_shape = xs[1]->shape();
+			return { as_array((*xs[0])[0] + (*xs[1])[0]) };
+		}
+
 		auto x0 = *(xs[0]);
 		auto x1 = *(xs[1]);
 
@@ -482,8 +1308,7 @@ public:
 		// NdArray̎lZÕu[hLXg
 		utils::broadcast_mutual(x0, x1);
 
-		auto y = x0 + x1;
-		return { as_array(y) };
+		return { map_array(x0, x1, [](data_t a, data_t b) { return a + b; }) };
 	}
 	// t`d
 	VariablePtrList backward(const VariablePtrList& gys) override
@@ -498,6 +1323,11 @@ public:
 		}
 		return { gx0, gx1 };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		return { tangent_add(txs[0], txs[1]) };
+	}
 };
 
 // ֐NXiZj
@@ -508,9 +1338,20 @@ public:
 	nc::Shape x0_shape;
 	nc::Shape x1_shape;
 
+	// t`dœo̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+	bool need_outputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
+		// XJ[m̏ꍇ̓u[hLXgȂĒڌvZ
+		if (is_scalar(*xs[0]) && is_scalar(*xs[1])) {
+			x0_shape = xs[0]->shape();
+			x1_shape = xs[1]->shape();
+			return { as_array((*xs[0])[0] - (*xs[1])[0]) };
+		}
+
 		auto x0 = *(xs[0]);
 		auto x1 = *(xs[1]);
 
@@ -521,12 +1362,16 @@ public:
 		// NdArray̎lZÕu[hLXg
 		utils::broadcast_mutual(x0, x1);
 
-		auto y = x0 - x1;
-		return { as_array(y) };
+		return { map_array(x0, x1, [](data_t a, data_t b) { return a - b; }) };
 	}
 	// t`d
 	VariablePtrList backward(const VariablePtrList& gys) override
 	{
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar_backward(gys[0])) {
+			return { gys[0], as_variable(as_array(-scalar_value(gys[0]))) };
+		}
+
 		auto gx0 = gys[0];
 		auto gx1 = -gys[0];
 
@@ -537,29 +1382,48 @@ public:
 		}
 		return { gx0, gx1 };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		return { tangent_add(txs[0], tangent_scale(txs[1], -1.0)) };
+	}
 };
 
 // ֐NXiZj
 class Mul : public Function
 {
 public:
+	// t`dŏo̓f[^̒l͎gpȂ
+	bool need_outputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
+		// XJ[m̏ꍇ̓u[hLXgȂĒڌvZ
+		if (is_scalar(*xs[0]) && is_scalar(*xs[1])) {
+			return { as_array((*xs[0])[0] * (*xs[1])[0]) };
+		}
+
 		auto x0 = *(xs[0]);
 		auto x1 = *(xs[1]);
 
 		// NdArray̎lZÕu[hLXg
 		utils::broadcast_mutual(x0, x1);
 
-		auto y = x0 * x1;
-		return { as_array(y) };
+		return { map_array(x0, x1, [](data_t a, data_t b) { return a * b; }) };
 	}
 	// t`d
 	VariablePtrList backward(const VariablePtrList& gys) override
 	{
 		auto x0 = this->inputs[0];
 		auto x1 = this->inputs[1];
+
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar_backward(gys[0], x0, x1)) {
+			auto gy = scalar_value(gys[0]);
+			return { as_variable(as_array(gy * scalar_value(x1))), as_variable(as_array(gy * scalar_value(x0))) };
+		}
+
 		auto gx0 = gys[0] * x1;
 		auto gx1 = gys[0] * x0;
 
@@ -570,23 +1434,35 @@ public:
 		}
 		return { gx0, gx1 };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& xs, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		return { tangent_add(tangent_mul(txs[0], *xs[1]), tangent_mul(txs[1], *xs[0])) };
+	}
 };
 
 // ֐NXiZj
 class Div : public Function
 {
 public:
+	// t`dŏo̓f[^̒l͎gpȂ
+	bool need_outputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
+		// XJ[m̏ꍇ̓u[hLXgȂĒڌvZ
+		if (is_scalar(*xs[0]) && is_scalar(*xs[1])) {
+			return { as_array((*xs[0])[0] / (*xs[1])[0]) };
+		}
+
 		auto x0 = *(xs[0]);
 		auto x1 = *(xs[1]);
 
 		// NdArray̎lZÕu[hLXg
 		utils::broadcast_mutual(x0, x1);
 
-		auto y = x0 / x1;
-		return { as_array(y) };
+		return { map_array(x0, x1, [](data_t a, data_t b) { return a / b; }) };
 	}
 	// t`d
 	VariablePtrList backward(const VariablePtrList& gys) override
@@ -594,6 +1470,15 @@ public:
 		auto x0 = this->inputs[0];
 		auto x1 = this->inputs[1];
 		auto gy = gys[0];
+
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar_backward(gy, x0, x1)) {
+			auto a0 = scalar_value(x0);
+			auto a1 = scalar_value(x1);
+			auto g = scalar_value(gy);
+			return { as_variable(as_array(g / a1)), as_variable(as_array(g * (-a0 / nc::power(a1, 2)))) };
+		}
+
 		auto gx0 = gy / x1;
 		auto gx1 = gy * (-x0 / power(x1, 2));
 
@@ -604,42 +1489,75 @@ public:
 		}
 		return { gx0, gx1 };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& xs, const NdArrayPtrList& ys, const NdArrayPtrList& txs) override
+	{
+		// (tx0 - y * tx1) / x1
+		auto t = tangent_add(txs[0], tangent_scale(tangent_mul(txs[1], *ys[0]), -1.0));
+		return { tangent_div(t, *xs[1]) };
+	}
 };
 
 // ֐NXij
 class Pos : public Function
 {
 public:
+	// t`dœo̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+	bool need_outputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
 		// ͒l̂܂ܕԂA`dł͐VCX^XɂKv
-		auto x = *(xs[0]);
-		return { as_array(x) };
+		return { as_array(*(xs[0])) };
 	}
 	// t`d
 	VariablePtrList backward(const VariablePtrList& gys) override
 	{
 		return gys;
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		return { txs[0] };
+	}
 };
 
 // ֐NXij
 class Neg : public Function
 {
 public:
+	// t`dœo̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+	bool need_outputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
-		auto x = *(xs[0]);
-		return { as_array(-x) };
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar(*xs[0])) {
+			return { as_array(-(*xs[0])[0]) };
+		}
+
+		return { map_array(*(xs[0]), [](data_t a) { return -a; }) };
 	}
 	// t`d
 	VariablePtrList backward(const VariablePtrList& gys) override
 	{
 		auto gy = gys[0];
+
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar_backward(gy)) {
+			return { as_variable(as_array(-scalar_value(gy))) };
+		}
 		return { -gy };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		return { tangent_scale(txs[0], -1.0) };
+	}
 };
 
 // ֐NXiݏj
@@ -651,9 +1569,17 @@ public:
 	// RXgN^
 	Pow(uint32_t c) : c(c) {}
 
+	// t`dŏo̓f[^̒l͎gpȂ
+	bool need_outputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar(*xs[0])) {
+			return { as_array(nc::power((*xs[0])[0], this->c)) };
+		}
+
 		auto x = *(xs[0]);
 		auto y = nc::power(x, this->c);
 		return { as_array(y) };
@@ -664,9 +1590,255 @@ public:
 		auto x = this->inputs[0];
 		auto gy = gys[0];
 		auto c = this->c;
+
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar_backward(gy, x)) {
+			return { as_variable(as_array(nc::power(scalar_value(x), c - 1) * static_cast<data_t>(c) * scalar_value(gy))) };
+		}
+
 		auto gx = static_cast<data_t>(c)* power(x, c - 1) * gy;
 		return { gx };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& xs, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		auto c = static_cast<data_t>(this->c);
+		auto d = map_array(*xs[0], [c](data_t a) { return c * std::pow(a, c - 1); });
+		return { tangent_mul(txs[0], *d) };
+	}
+};
+
+// ֐NXi萔̉Z x + cj
+// 萔 Variable ƂĈȂ߁Au[hLXg萔ւ̌zvZsv
+class AddScalar : public Function
+{
+public:
+	data_t c;
+
+	// RXgN^
+	AddScalar(data_t c) : c(c) {}
+
+	// t`dœo̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+	bool need_outputs() const override { return false; }
+
+	// `d
+	NdArrayPtrList forward(const NdArrayPtrList& xs) override
+	{
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar(*xs[0])) {
+			return { as_array((*xs[0])[0] + this->c) };
+		}
+		auto c = this->c;
+		return { map_array(*(xs[0]), [c](data_t a) { return a + c; }) };
+	}
+	// t`d
+	VariablePtrList backward(const VariablePtrList& gys) override
+	{
+		return { gys[0] };
+	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		return { txs[0] };
+	}
+};
+
+// ֐NXi萔̌Z x - cj
+class SubScalar : public Function
+{
+public:
+	data_t c;
+
+	// RXgN^
+	SubScalar(data_t c) : c(c) {}
+
+	// t`dœo̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+	bool need_outputs() const override { return false; }
+
+	// `d
+	NdArrayPtrList forward(const NdArrayPtrList& xs) override
+	{
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar(*xs[0])) {
+			return { as_array((*xs[0])[0] - this->c) };
+		}
+		auto c = this->c;
+		return { map_array(*(xs[0]), [c](data_t a) { return a - c; }) };
+	}
+	// t`d
+	VariablePtrList backward(const VariablePtrList& gys) override
+	{
+		return { gys[0] };
+	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		return { txs[0] };
+	}
+};
+
+// ֐NXi萔̌Z c - xj
+class RSub : public Function
+{
+public:
+	data_t c;
+
+	// RXgN^
+	RSub(data_t c) : c(c) {}
+
+	// t`dœo̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+	bool need_outputs() const override { return false; }
+
+	// `d
+	NdArrayPtrList forward(const NdArrayPtrList& xs) override
+	{
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar(*xs[0])) {
+			return { as_array(this->c - (*xs[0])[0]) };
+		}
+		auto c = this->c;
+		return { map_array(*(xs[0]), [c](data_t a) { return c - a; }) };
+	}
+	// t`d
+	VariablePtrList backward(const VariablePtrList& gys) override
+	{
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar_backward(gys[0])) {
+			return { as_variable(as_array(-scalar_value(gys[0]))) };
+		}
+		return { -gys[0] };
+	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		return { tangent_scale(txs[0], -1.0) };
+	}
+};
+
+// ֐NXi萔̏Z x * cj
+class MulScalar : public Function
+{
+public:
+	data_t c;
+
+	// RXgN^
+	MulScalar(data_t c) : c(c) {}
+
+	// t`dœo̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+	bool need_outputs() const override { return false; }
+
+	// `d
+	NdArrayPtrList forward(const NdArrayPtrList& xs) override
+	{
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar(*xs[0])) {
+			return { as_array((*xs[0])[0] * this->c) };
+		}
+		auto c = this->c;
+		return { map_array(*(xs[0]), [c](data_t a) { return a * c; }) };
+	}
+	// t`d
+	VariablePtrList backward(const VariablePtrList& gys) override
+	{
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar_backward(gys[0])) {
+			return { as_variable(as_array(scalar_value(gys[0]) * this->c)) };
+		}
+		return { gys[0] * this->c };
+	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		return { tangent_scale(txs[0], this->c) };
+	}
+};
+
+// ֐NXi萔̏Z x / cj
+class DivScalar : public Function
+{
+public:
+	data_t c;
+
+	// RXgN^
+	DivScalar(data_t c) : c(c) {}
+
+	// t`dœo̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+	bool need_outputs() const override { return false; }
+
+	// `d
+	NdArrayPtrList forward(const NdArrayPtrList& xs) override
+	{
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar(*xs[0])) {
+			return { as_array((*xs[0])[0] / this->c) };
+		}
+		auto c = this->c;
+		return { map_array(*(xs[0]), [c](data_t a) { return a / c; }) };
+	}
+	// t`d
+	VariablePtrList backward(const VariablePtrList& gys) override
+	{
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar_backward(gys[0])) {
+			return { as_variable(as_array(scalar_value(gys[0]) / this->c)) };
+		}
+		return { gys[0] / this->c };
+	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		return { tangent_scale(txs[0], 1.0 / this->c) };
+	}
+};
+
+// ֐NXi萔̏Z c / xj
+class RDiv : public Function
+{
+public:
+	data_t c;
+
+	// RXgN^
+	RDiv(data_t c) : c(c) {}
+
+	// t`dŏo̓f[^̒l͎gpȂ
+	bool need_outputs() const override { return false; }
+
+	// `d
+	NdArrayPtrList forward(const NdArrayPtrList& xs) override
+	{
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar(*xs[0])) {
+			return { as_array(this->c / (*xs[0])[0]) };
+		}
+		auto c = this->c;
+		return { map_array(*(xs[0]), [c](data_t a) { return c / a; }) };
+	}
+	// t`d
+	VariablePtrList backward(const VariablePtrList& gys) override
+	{
+		auto x = this->inputs[0];
+		auto gy = gys[0];
+
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar_backward(gy, x)) {
+			return { as_variable(as_array(scalar_value(gy) * (-this->c / nc::power(scalar_value(x), 2)))) };
+		}
+
+		auto gx = gy * (-this->c / power(x, 2));
+		return { gx };
+	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& xs, const NdArrayPtrList& ys, const NdArrayPtrList& txs) override
+	{
+		// -c / x^2 = -y / x
+		auto d = map_array(*xs[0], *ys[0], [](data_t x, data_t y) { return -y / x; });
+		return { tangent_mul(txs[0], *d) };
+	}
 };
 
 //----------------------------------
@@ -712,7 +1884,7 @@ inline std::ostream& operator<<(std::ostream& ost, const VariablePtr& p)
 // Z
 inline VariablePtr add(const VariablePtr& x0, const VariablePtr& x1)
 {
-	FunctionPtr f = std::make_shared<Add>();
+	FunctionPtr f = make_node<Add>();
 	VariablePtrList args = { x0, x1 };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -721,7 +1893,7 @@ inline VariablePtr add(const VariablePtr& x0, const VariablePtr& x1)
 // Z
 inline VariablePtr sub(const VariablePtr& x0, const VariablePtr& x1)
 {
-	FunctionPtr f = std::make_shared<Sub>();
+	FunctionPtr f = make_node<Sub>();
 	VariablePtrList args = { x0, x1 };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -730,7 +1902,7 @@ inline VariablePtr sub(const VariablePtr& x0, const VariablePtr& x1)
 // Z
 inline VariablePtr mul(const VariablePtr& x0, const VariablePtr& x1)
 {
-	FunctionPtr f = std::make_shared<Mul>();
+	FunctionPtr f = make_node<Mul>();
 	VariablePtrList args = { x0, x1 };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -739,16 +1911,70 @@ inline VariablePtr mul(const VariablePtr& x0, const VariablePtr& x1)
 // Z
 inline VariablePtr div(const VariablePtr& x0, const VariablePtr& x1)
 {
-	FunctionPtr f = std::make_shared<Div>();
+	FunctionPtr f = make_node<Div>();
 	VariablePtrList args = { x0, x1 };
 	auto ys = (*f)(args);
 	return ys[0];
 }
 
+// 萔̉Z
+inline VariablePtr add(const VariablePtr& x, data_t c)
+{
+	FunctionPtr f = make_node<AddScalar>(c);
+	VariablePtrList args = { x };
+	auto ys = (*f)(args);
+	return ys[0];
+}
+
+// 萔̌Z
+inline VariablePtr sub(const VariablePtr& x, data_t c)
+{
+	FunctionPtr f = make_node<SubScalar>(c);
+	VariablePtrList args = { x };
+	auto ys = (*f)(args);
+	return ys[0];
+}
+
+// 萔̌Z
+inline VariablePtr rsub(const VariablePtr& x, data_t c)
+{
+	FunctionPtr f = make_node<RSub>(c);
+	VariablePtrList args = { x };
+	auto ys = (*f)(args);
+	return ys[0];
+}
+
+// 萔̏Z
+inline VariablePtr mul(const VariablePtr& x, data_t c)
+{
+	FunctionPtr f = make_node<MulScalar>(c);
+	VariablePtrList args = { x };
+	auto ys = (*f)(args);
+	return ys[0];
+}
+
+// 萔̏Z
+inline VariablePtr div(const VariablePtr& x, data_t c)
+{
+	FunctionPtr f = make_node<DivScalar>(c);
+	VariablePtrList args = { x };
+	auto ys = (*f)(args);
+	return ys[0];
+}
+
+// 萔̏Zi萔鐔Ƃj
+inline VariablePtr rdiv(const VariablePtr& x, data_t c)
+{
+	FunctionPtr f = make_node<RDiv>(c);
+	VariablePtrList args = { x };
+	auto ys = (*f)(args);
+	return ys[0];
+}
+
 // 
 inline VariablePtr pos(const VariablePtr& x)
 {
-	FunctionPtr f = std::make_shared<Pos>();
+	FunctionPtr f = make_node<Pos>();
 	VariablePtrList args = { x };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -757,7 +1983,7 @@ inline VariablePtr pos(const VariablePtr& x)
 // 
 inline VariablePtr neg(const VariablePtr& x)
 {
-	FunctionPtr f = std::make_shared<Neg>();
+	FunctionPtr f = make_node<Neg>();
 	VariablePtrList args = { x };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -766,7 +1992,7 @@ inline VariablePtr neg(const VariablePtr& x)
 // ݏ
 inline VariablePtr power(const VariablePtr& x, uint32_t c)
 {
-	FunctionPtr f = std::make_shared<Pow>(c);
+	FunctionPtr f = make_node<Pow>(c);
 	VariablePtrList args = { x };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -785,29 +2011,30 @@ inline VariablePtr power(data_t x, uint32_t c)
 inline VariablePtr operator+(const VariablePtr& lhs, const VariablePtr& rhs) { return add(lhs, rhs); }
 inline VariablePtr operator+(const VariablePtr& lhs, const NdArrayPtr& rhs) { return add(lhs, as_variable(rhs)); }
 inline VariablePtr operator+(const NdArrayPtr& lhs, const VariablePtr& rhs) { return add(as_variable(lhs), rhs); }
-inline VariablePtr operator+(const VariablePtr& lhs, data_t rhs) { return add(lhs, as_variable(as_array(rhs))); }
-inline VariablePtr operator+(data_t lhs, const VariablePtr& rhs) { return add(as_variable(as_array(lhs)), rhs); }
+inline VariablePtr operator+(const VariablePtr& lhs, data_t rhs) { return add(lhs, rhs); }
+inline VariablePtr operator+(data_t lhs, const VariablePtr& rhs) { return add(rhs, lhs); }
 // 񍀉Zq -
 inline VariablePtr operator-(const VariablePtr& lhs, const VariablePtr& rhs) { return sub(lhs, rhs); }
 inline VariablePtr operator-(const VariablePtr& lhs, const NdArrayPtr& rhs) { return sub(lhs, as_variable(rhs)); }
 inline VariablePtr operator-(const NdArrayPtr& lhs, const VariablePtr& rhs) { return sub(as_variable(lhs), rhs); }
-inline VariablePtr operator-(const VariablePtr& lhs, data_t rhs) { return sub(lhs, as_variable(as_array(rhs))); }
-inline VariablePtr operator-(data_t lhs, const VariablePtr& rhs) { return sub(as_variable(as_array(lhs)), rhs); }
+inline VariablePtr operator-(const VariablePtr& lhs, data_t rhs) { return sub(lhs, rhs); }
+inline VariablePtr operator-(data_t lhs, const VariablePtr& rhs) { return rsub(rhs, lhs); }
 // 񍀉Zq *
 inline VariablePtr operator*(const VariablePtr& lhs, const VariablePtr& rhs) { return mul(lhs, rhs); }
 inline VariablePtr operator*(const VariablePtr& lhs, const NdArrayPtr& rhs) { return mul(lhs, as_variable(rhs)); }
 inline VariablePtr operator*(const NdArrayPtr& lhs, const VariablePtr& rhs) { return mul(as_variable(lhs), rhs); }
-inline VariablePtr operator*(const VariablePtr& lhs, data_t rhs) { return mul(lhs, as_variable(as_array(rhs))); }
-inline VariablePtr operator*(data_t lhs, const VariablePtr& rhs) { return mul(as_variable(as_array(lhs)), rhs); }
+inline VariablePtr operator*(const VariablePtr& lhs, data_t rhs) { return mul(lhs, rhs); }
+inline VariablePtr operator*(data_t lhs, const VariablePtr& rhs) { return mul(rhs, lhs); }
 // 񍀉Zq /
 inline VariablePtr operator/(const VariablePtr& lhs, const VariablePtr& rhs) { return div(lhs, rhs); }
 inline VariablePtr operator/(const VariablePtr& lhs, const NdArrayPtr& rhs) { return div(lhs, as_variable(rhs)); }
 inline VariablePtr operator/(const NdArrayPtr& lhs, const VariablePtr& rhs) { return div(as_variable(lhs), rhs); }
-inline VariablePtr operator/(const VariablePtr& lhs, data_t rhs) { return div(lhs, as_variable(as_array(rhs))); }
-inline VariablePtr operator/(data_t lhs, const VariablePtr& rhs) { return div(as_variable(as_array(lhs)), rhs); }
+inline VariablePtr operator/(const VariablePtr& lhs, data_t rhs) { return div(lhs, rhs); }
+inline VariablePtr operator/(data_t lhs, const VariablePtr& rhs) { return rdiv(rhs, lhs); }
 // PZq +
 inline VariablePtr operator+(const VariablePtr& data) { return pos(data); }
 // PZq -
 inline VariablePtr operator-(const VariablePtr& data) { return neg(data); }
 
 }	// namespace dezerocpp
+
@@ -6,23 +6,40 @@
 #include <filesystem>
 #define _USE_MATH_DEFINES
 #include <cmath>
+#include <cstring>
 #include <string>
 #include <list>
+#include <deque>
 #include <vector>
+#include <array>
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
 #include <variant>
 #include <functional>
+#include <new>
+#include <stdexcept>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <random>
+#ifdef __linux__
+#if __has_include(<sys/single_threaded.h>)
+#include <sys/single_threaded.h>
+#endif	// #if __has_include(<sys/single_threaded.h>)
+#endif	// #ifdef __linux__
 
 #include "NumCpp.hpp"
 
-//#define IS_SIMPLE_CORE
-#ifdef IS_SIMPLE_CORE
-#include "core_simple.hpp"
-#else
+#include "memory.hpp"
+#include "parallel.hpp"
+#include "ref.hpp"
+#include "small_vector.hpp"
+
 #include "core.hpp"
-#endif	// #ifdef IS_SIMPLE_CORE
 
+#include "expr.hpp"
 #include "functions.hpp"
 #include "layers.hpp"
 #include "models.hpp"
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "../dezero/dezero.hpp"
+
+namespace dz::expr
+{
+
+//----------------------------------
+// class
+//----------------------------------
+
+// ev[g̊NX (CRTP)
+// Zqd˂ĂꎞI NdArray ͐AɂP̃[vł܂Ƃ߂ĕ]
+template<typename E>
+struct Expr
+{
+	const E& self() const { return static_cast<const E&>(*this); }
+};
+
+// [̎iQƂ݂̂ NdArrayj
+struct Leaf : Expr<Leaf>
+{
+	const data_t* p;
+	size_t n;
+
+	Leaf(const NdArray& a) :
+		p(a.data()),
+		n(a.size())
+	{}
+	Leaf(const data_t* p, size_t n) :
+		p(p),
+		n(n)
+	{}
+
+	data_t operator[](size_t i) const { return p[i]; }
+	size_t size() const { return n; }
+};
+
+// [̎iXJ[j
+// vf 0 ͔Cӂ̃TCYɈv鈵Ƃ
+struct Scalar : Expr<Scalar>
+{
+	data_t v;
+
+	Scalar(data_t v) :
+		v(v)
+	{}
+
+	data_t operator[](size_t) const { return v; }
+	size_t size() const { return 0; }
+};
+
+// Z̎
+struct OpAdd { static data_t apply(data_t a, data_t b) { return a + b; } };
+struct OpSub { static data_t apply(data_t a, data_t b) { return a - b; } };
+struct OpMul { static data_t apply(data_t a, data_t b) { return a * b; } };
+struct OpDiv { static data_t apply(data_t a, data_t b) { return a / b; } };
+
+// 񍀉Z̎
+template<typename L, typename R, typename Op>
+struct Binary : Expr<Binary<L, R, Op>>
+{
+	L l;
+	R r;
+
+	Binary(const L& l, const R& r) :
+		l(l),
+		r(r)
+	{
+		// u[hLXg͍sȂߗvfvKv
+		assert(l.size() == 0 || r.size() == 0 || l.size() == r.size());
+	}
+
+	data_t operator[](size_t i) const { return Op::apply(l[i], r[i]); }
+	size_t size() const { return l.size() != 0 ? l.size() : r.size(); }
+};
+
+// P}CiX̎
+template<typename E>
+struct Negate : Expr<Negate<E>>
+{
+	E e;
+
+	Negate(const E& e) :
+		e(e)
+	{}
+
+	data_t operator[](size_t i) const { return -e[i]; }
+	size_t size() const { return e.size(); }
+};
+
+// ̎i\ NdArrayj
+// Eӂ̎vfƂɂP̃[vŕ]ď
+struct Target : Expr<Target>
+{
+	data_t* p;
+	size_t n;
+
+	Target(NdArray& a) :
+		p(a.data()),
+		n(a.size())
+	{}
+	Target(data_t* p, size_t n) :
+		p(p),
+		n(n)
+	{}
+	// Rs[RXgN^
+	// Rs[͓ NdArray wQƂɂȂivf̓Rs[ȂjBvfƂɕ]Ƌʂ邽 explicit ƂA
+	// @Target b = a; ̂悤Ȓl̃Rs[Ɍ鏑͂łȂ悤ɂi̓ɕێꍇ̂ݎgj
+	explicit Target(const Target&) = default;
+
+	data_t operator[](size_t i) const { return p[i]; }
+	size_t size() const { return n; }
+
+	// Zq
+	template<typename E> Target& operator=(const Expr<E>& e) { return this->assign(e.self(), [](data_t& d, data_t s) { d = s; }); }
+	template<typename E> Target& operator+=(const Expr<E>& e) { return this->assign(e.self(), [](data_t& d, data_t s) { d += s; }); }
+	template<typename E> Target& operator-=(const Expr<E>& e) { return this->assign(e.self(), [](data_t& d, data_t s) { d -= s; }); }
+	template<typename E> Target& operator*=(const Expr<E>& e) { return this->assign(e.self(), [](data_t& d, data_t s) { d *= s; }); }
+	template<typename E> Target& operator/=(const Expr<E>& e) { return this->assign(e.self(), [](data_t& d, data_t s) { d /= s; }); }
+	Target& operator=(const Target& e) { return this->assign(e, [](data_t& d, data_t s) { d = s; }); }
+	Target& operator=(data_t v) { return *this = Scalar(v); }
+	Target& operator+=(data_t v) { return *this += Scalar(v); }
+	Target& operator-=(data_t v) { return *this -= Scalar(v); }
+	Target& operator*=(data_t v) { return *this *= Scalar(v); }
+	Target& operator/=(data_t v) { return *this /= Scalar(v); }
+
+private:
+	// ][v
+	// vfꍇ̓Xbhv[ŕĕ]i^XN̒Ă΂ꂽꍇ͂̃Xbhŕ]j
+	template<typename E, typename F>
+	Target& assign(const E& e, F f)
+	{
+		assert(e.size() == 0 || e.size() == this->n);
+		auto p = this->p;
+		parallel::parallel_for(0, this->n, parallel::default_grain, [p, &e, f](size_t first, size_t last) {
+			for (auto i = first; i < last; i++) {
+				f(p[i], e[i]);
+			}
+		});
+		return *this;
+	}
+};
+
+//----------------------------------
+// function
+//----------------------------------
+
+// NdArray ɕϊ
+inline Target ref(NdArray& a) { return Target(a); }
+inline Leaf ref(const NdArray& a) { return Leaf(a); }
+// Avf͈̔͂ɕϊ
+inline Target ref(data_t* p, size_t n) { return Target(p, n); }
+inline Leaf ref(const data_t* p, size_t n) { return Leaf(p, n); }
+
+// ZqI[o[[h
+template<typename L, typename R> Binary<L, R, OpAdd> operator+(const Expr<L>& l, const Expr<R>& r) { return { l.self(), r.self() }; }
+template<typename L, typename R> Binary<L, R, OpSub> operator-(const Expr<L>& l, const Expr<R>& r) { return { l.self(), r.self() }; }
+template<typename L, typename R> Binary<L, R, OpMul> operator*(const Expr<L>& l, const Expr<R>& r) { return { l.self(), r.self() }; }
+template<typename L, typename R> Binary<L, R, OpDiv> operator/(const Expr<L>& l, const Expr<R>& r) { return { l.self(), r.self() }; }
+template<typename L> Binary<L, Scalar, OpAdd> operator+(const Expr<L>& l, data_t r) { return { l.self(), Scalar(r) }; }
+template<typename L> Binary<L, Scalar, OpSub> operator-(const Expr<L>& l, data_t r) { return { l.self(), Scalar(r) }; }
+template<typename L> Binary<L, Scalar, OpMul> operator*(const Expr<L>& l, data_t r) { return { l.self(), Scalar(r) }; }
+template<typename L> Binary<L, Scalar, OpDiv> operator/(const Expr<L>& l, data_t r) { return { l.self(), Scalar(r) }; }
+template<typename R> Binary<Scalar, R, OpAdd> operator+(data_t l, const Expr<R>& r) { return { Scalar(l), r.self() }; }
+template<typename R> Binary<Scalar, R, OpSub> operator-(data_t l, const Expr<R>& r) { return { Scalar(l), r.self() }; }
+template<typename R> Binary<Scalar, R, OpMul> operator*(data_t l, const Expr<R>& r) { return { Scalar(l), r.self() }; }
+template<typename R> Binary<Scalar, R, OpDiv> operator/(data_t l, const Expr<R>& r) { return { Scalar(l), r.self() }; }
+template<typename E> Negate<E> operator-(const Expr<E>& e) { return { e.self() }; }
+
+}	// namespace dz::expr
@@ -20,84 +20,156 @@ using function_t = VariablePtrList(const VariablePtrList&);
 class Sin : public Function
 {
 public:
+	// t`dŏo̓f[^̒l͎gpȂ
+	bool need_outputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
-		auto x = *(xs[0]);
-		auto y = nc::sin(x);
-		return { as_array(y) };
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar(*xs[0])) {
+			return { as_array(nc::sin((*xs[0])[0])) };
+		}
+
+		return { map_array(*(xs[0]), [](data_t a) { return std::sin(a); }) };
 	}
 	// t`d
 	VariablePtrList backward(const VariablePtrList& gys) override
 	{
 		auto x = this->inputs[0];
 		auto gy = gys[0];
+
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar_backward(gy, x)) {
+			return { as_variable(as_array(scalar_value(gy) * std::cos(scalar_value(x)))) };
+		}
+
 		auto gx = gy * cos(x);
 		return { gx };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& xs, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		auto d = map_array(*xs[0], [](data_t a) { return std::cos(a); });
+		return { tangent_mul(txs[0], *d) };
+	}
 };
 
 // ֐NXicosj
 class Cos : public Function
 {
 public:
+	// t`dŏo̓f[^̒l͎gpȂ
+	bool need_outputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
-		auto x = *(xs[0]);
-		auto y = nc::cos(x);
-		return { as_array(y) };
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar(*xs[0])) {
+			return { as_array(nc::cos((*xs[0])[0])) };
+		}
+
+		return { map_array(*(xs[0]), [](data_t a) { return std::cos(a); }) };
 	}
 	// t`d
 	VariablePtrList backward(const VariablePtrList& gys) override
 	{
 		auto x = this->inputs[0];
 		auto gy = gys[0];
+
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar_backward(gy, x)) {
+			return { as_variable(as_array(scalar_value(gy) * -std::sin(scalar_value(x)))) };
+		}
+
 		auto gx = gy * -sin(x);
 		return { gx };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& xs, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		auto d = map_array(*xs[0], [](data_t a) { return -std::sin(a); });
+		return { tangent_mul(txs[0], *d) };
+	}
 };
 
 // ֐NXitanhj
 class Tanh : public Function
 {
 public:
+	// t`dœ̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
-		auto x = *(xs[0]);
-		auto y = nc::tanh(x);
-		return { as_array(y) };
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar(*xs[0])) {
+			return { as_array(nc::tanh((*xs[0])[0])) };
+		}
+
+		return { map_array(*(xs[0]), [](data_t a) { return std::tanh(a); }) };
 	}
 	// t`d
 	VariablePtrList backward(const VariablePtrList& gys) override
 	{
 		auto y = this->outputs[0].lock();
 		auto gy = gys[0];
+
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar_backward(gy, y)) {
+			auto a = scalar_value(y);
+			return { as_variable(as_array(scalar_value(gy) * (1 - a * a))) };
+		}
+
 		auto gx = gy * (1 - y * y);
 		return { gx };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& ys, const NdArrayPtrList& txs) override
+	{
+		auto d = map_array(*ys[0], [](data_t y) { return 1 - y * y; });
+		return { tangent_mul(txs[0], *d) };
+	}
 };
 
 // ֐NXiexpj
 class Exp : public Function
 {
 public:
+	// t`dœ̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
-		auto x = *(xs[0]);
-		auto y = nc::exp(x);
-		return { as_array(y) };
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar(*xs[0])) {
+			return { as_array(nc::exp((*xs[0])[0])) };
+		}
+
+		return { map_array(*(xs[0]), [](data_t a) { return std::exp(a); }) };
 	}
 	// t`d
 	VariablePtrList backward(const VariablePtrList& gys) override
 	{
 		auto y = this->outputs[0].lock();
 		auto gy = gys[0];
+
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar_backward(gy, y)) {
+			return { as_variable(as_array(scalar_value(gy) * scalar_value(y))) };
+		}
+
 		auto gx = gy * y;
 		return { gx };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& ys, const NdArrayPtrList& txs) override
+	{
+		return { tangent_mul(txs[0], *ys[0]) };
+	}
 };
 
 // ֐NXireshapej
@@ -114,6 +186,10 @@ public:
 		shape(shape)
 	{}
 
+	// t`dœo̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+	bool need_outputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
@@ -129,12 +205,22 @@ public:
 		auto gx = reshape(gy, this->x_shape);
 		return { gx };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		auto t = *(txs[0]);
+		return { as_array(t.reshape(this->shape)) };
+	}
 };
 
 // ֐NXitransposej
 class Transpose : public Function
 {
 public:
+	// t`dœo̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+	bool need_outputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
@@ -149,6 +235,11 @@ public:
 		auto gx = transpose(gy);
 		return { gx };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		return { as_array(txs[0]->transpose()) };
+	}
 };
 
 // ֐NXisumj
@@ -165,12 +256,16 @@ public:
 		axis(axis)
 	{}
 
+	// t`dœo̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+	bool need_outputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
 		auto x = *(xs[0]);
 		this->x_shape = x.shape();
-		auto y = x.sum(this->axis);
+		auto y = utils::sum(x, this->axis);
 		return { as_array(y) };
 	}
 	// t`d
@@ -181,6 +276,11 @@ public:
 		auto gx = broadcast_to(gy, this->x_shape);
 		return { gx };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		return { as_array(utils::sum(*txs[0], this->axis)) };
+	}
 };
 
 // ֐NXibroadcast_toj
@@ -197,6 +297,10 @@ public:
 		shape(shape)
 	{}
 
+	// t`dœo̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+	bool need_outputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
@@ -212,6 +316,11 @@ public:
 		auto gx = sum_to(gy, this->x_shape);
 		return { gx };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		return { as_array(utils::broadcast_to(*txs[0], this->shape)) };
+	}
 };
 
 // ֐NXisum_toj
@@ -228,6 +337,10 @@ public:
 		shape(shape)
 	{}
 
+	// t`dœo̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+	bool need_outputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
@@ -243,18 +356,26 @@ public:
 		auto gx = broadcast_to(gy, this->x_shape);
 		return { gx };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		return { as_array(utils::sum_to(*txs[0], this->shape)) };
+	}
 };
 
 // ֐NXimatmulj
 class MatMul : public Function
 {
 public:
+	// t`dŏo̓f[^̒l͎gpȂ
+	bool need_outputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
 		auto x = *(xs[0]);
 		auto W = *(xs[1]);
-		auto y = x.dot(W);
+		auto y = utils::dot(x, W);
 		return { as_array(y) };
 	}
 	// t`d
@@ -267,18 +388,29 @@ public:
 		auto gW = matmul(x->transpose(), gy);
 		return { gx, gW };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& xs, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		// txEW + xEtW
+		auto t0 = txs[0] ? as_array(utils::dot(*txs[0], *xs[1])) : nullptr;
+		auto t1 = txs[1] ? as_array(utils::dot(*xs[0], *txs[1])) : nullptr;
+		return { tangent_add(t0, t1) };
+	}
 };
 
 // ֐NXi`ϊ/Sj
 class Linear : public Function
 {
 public:
+	// t`dŏo̓f[^̒l͎gpȂ
+	bool need_outputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
 		auto x = *(xs[0]);
 		auto W = *(xs[1]);
-		auto y = x.dot(W);
+		auto y = utils::dot(x, W);
 		if (xs.size() >= 3 && xs[2]) {
 			auto b = *(xs[2]);
 			utils::broadcast_mutual(y, b);	// NdArray̎lZÕu[hLXg
@@ -299,36 +431,106 @@ public:
 		}
 		auto gx = matmul(gy, W->transpose());
 		auto gW = matmul(x->transpose(), gy);
+
+		// TvƂ̌ziIvVj
+		if (Config::get_instance().flags.per_sample_grad) {
+			this->backward_per_sample(*x->data, *gy->data);
+		}
 		return { gx, gW, gb };
 	}
+
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& xs, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		// txEW + xEtW + tb
+		auto t0 = txs[0] ? as_array(utils::dot(*txs[0], *xs[1])) : nullptr;
+		auto t1 = txs[1] ? as_array(utils::dot(*xs[0], *txs[1])) : nullptr;
+		auto t = tangent_add(t0, t1);
+		if (txs.size() >= 3) t = tangent_add(t, txs[2]);
+		return { t };
+	}
+
+private:
+	// TvisjƂ̃p[^̌zP̏ł܂Ƃ߂ċ߂
+	// W ̌z̓TvƂ̊O x_n^T gy_nAb ̌z gy_n ƂȂ
+	void backward_per_sample(const NdArray& x, const NdArray& gy)
+	{
+		auto N = static_cast<size_t>(x.shape().rows);
+		auto I = static_cast<size_t>(x.shape().cols);
+		auto O = static_cast<size_t>(gy.shape().cols);
+
+		if (auto W = node_cast<Parameter>(this->inputs[1])) {
+			auto g = pooled_array({ static_cast<uint32_t>(N), static_cast<uint32_t>(I * O) });
+			auto px = x.data();
+			auto pgy = gy.data();
+			auto pg = g->data();
+			auto grain = std::max<size_t>(parallel::default_grain / std::max<size_t>(I * O, 1), 1);
+			parallel::parallel_for(0, N, grain, [=](size_t first, size_t last) {
+				for (auto n = first; n < last; n++) {
+					auto row = pg + n * I * O;
+					for (size_t i = 0; i < I; i++) {
+						auto xi = px[n * I + i];
+						for (size_t o = 0; o < O; o++) row[i * O + o] = xi * pgy[n * O + o];
+					}
+				}
+			});
+			W->add_grad_sample(g);
+		}
+		if (auto b = node_cast<Parameter>(this->inputs[2])) {
+			if (b->data) b->add_grad_sample(as_array(gy));
+		}
+	}
 };
 
 // ֐NXiVOChj
 class Sigmoid : public Function
 {
 public:
+	// t`dœ̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
-		auto x = *(xs[0]);
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar(*xs[0])) {
+			return { as_array(nc::tanh((*xs[0])[0] * 0.5) * 0.5 + 0.5) };
+		}
+
 		//auto y = 1.0 / (1.0 + nc::exp(x));
-		auto y = nc::tanh(x * 0.5) * 0.5 + 0.5;	// ǂ@
-		return { as_array(y) };
+		//auto y = nc::tanh(x * 0.5) * 0.5 + 0.5;	// ǂ@
+		return { map_array(*(xs[0]), [](data_t a) { return std::tanh(a * 0.5) * 0.5 + 0.5; }) };
 	}
 	// t`d
 	VariablePtrList backward(const VariablePtrList& gys) override
 	{
 		auto y = this->outputs[0].lock();
 		auto gy = gys[0];
+
+		// XJ[̏ꍇ͒ڌvZ
+		if (is_scalar_backward(gy, y)) {
+			auto a = scalar_value(y);
+			return { as_variable(as_array(scalar_value(gy) * a * (1.0 - a))) };
+		}
+
 		auto gx = gy * y * (1.0 - y);
 		return { gx };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& ys, const NdArrayPtrList& txs) override
+	{
+		auto d = map_array(*ys[0], [](data_t y) { return y * (1 - y); });
+		return { tangent_mul(txs[0], *d) };
+	}
 };
 
 // ֐NXiϓ덷j
 class MeanSquaredError : public Function
 {
 public:
+	// t`dŏo̓f[^̒l͎gpȂ
+	bool need_outputs() const override { return false; }
+
 	// `d
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
@@ -350,6 +552,15 @@ public:
 		auto gx1 = -gx0;
 		return { gx0, gx1 };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& xs, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		// 2 / N * sum(diff * (tx0 - tx1))
+		auto t = tangent_add(txs[0], tangent_scale(txs[1], -1.0));
+		auto diff = broadcast_map(*xs[0], *xs[1], [](data_t a, data_t b) { return a - b; });
+		auto s = utils::sum(*tangent_mul(t, *diff), nc::Axis::NONE)[0];
+		return { as_array(s * 2.0 / static_cast<data_t>(diff->size())) };
+	}
 };
 
 // ֐NXiSoftmaxj
@@ -364,14 +575,44 @@ public:
 		axis(axis)
 	{}
 
+	// t`dœ̓f[^̒l͎gpȂ
+	bool need_inputs() const override { return false; }
+
 	// `d
+	// NdArray͎lZ̍ۂɎIɃu[hLXgȂ߁A̍őlƍv͗vf𒼐ڑċ߂
 	NdArrayPtrList forward(const NdArrayPtrList& xs) override
 	{
-		auto x = *(xs[0]);
-		auto y = x - x.max(axis);
-		y = nc::exp(y);
-		y /= y.sum(axis);
-		return { as_array(y) };
+		const auto& x = *(xs[0]);
+		auto rows = static_cast<size_t>(x.shape().rows);
+		auto cols = static_cast<size_t>(x.shape().cols);
+		auto y = pooled_array(x.shape());
+
+		// N[WF擪ʒu start Ԋu stride ŕ n ̗vf𐳋K
+		auto px = x.data();
+		auto py = y->data();
+		auto normalize = [px, py](size_t start, size_t n, size_t stride) {
+			auto m = px[start];
+			for (size_t k = 1; k < n; k++) m = std::max(m, px[start + k * stride]);
+			data_t s = 0;
+			for (size_t k = 0; k < n; k++) {
+				auto i = start + k * stride;
+				py[i] = std::exp(px[i] - m);
+				s += py[i];
+			}
+			for (size_t k = 0; k < n; k++) py[start + k * stride] /= s;
+		};
+
+		if (x.size() == 0) return { y };
+		if (this->axis == nc::Axis::ROW) {
+			for (size_t c = 0; c < cols; c++) normalize(c, rows, cols);
+		}
+		else if (this->axis == nc::Axis::COL) {
+			for (size_t r = 0; r < rows; r++) normalize(r * cols, cols, 1);
+		}
+		else {
+			normalize(0, x.size(), 1);
+		}
+		return { y };
 	}
 	// t`d
 	VariablePtrList backward(const VariablePtrList& gys) override
@@ -380,9 +621,128 @@ public:
 		auto y = this->outputs[0].lock();
 		auto gx = y * gy;
 		auto sumdx = gx->sum(axis);
+		// ̍v͍sxNgœ邽ߗxNgɂ
+		if (this->axis == nc::Axis::COL) sumdx = reshape(sumdx, { y->shape().rows, 1 });
 		gx = gx - y * sumdx;
 		return { gx };
 	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& /*xs*/, const NdArrayPtrList& ys, const NdArrayPtrList& txs) override
+	{
+		// y * tx - y * sum(y * tx)
+		auto t = tangent_mul(txs[0], *ys[0]);
+		auto s = as_array(utils::sum(*t, this->axis));
+		if (this->axis == nc::Axis::COL) s->reshape({ ys[0]->shape().rows, 1 });
+		return { tangent_add(t, tangent_scale(tangent_mul(s, *ys[0]), -1.0)) };
+	}
+};
+
+// ֐NXi`FbN|Cgj
+// `dł͓̌vZOtێAt`d̍ۂɏ`dČvZČz߂
+// [fŃgpʂ}ɏ`ďvZʂ
+class Checkpoint : public Function
+{
+public:
+	// ČvZ̑ΏۂƂȂ֐
+	std::function<function_t> func;
+
+	// RXgN^
+	Checkpoint(const std::function<function_t>& func) :
+		func(func)
+	{}
+
+	// t`dŏo̓f[^̒l͎gpȂ
+	bool need_outputs() const override { return false; }
+
+	// `d
+	NdArrayPtrList forward(const NdArrayPtrList& xs) override
+	{
+		// ̌vZOt͍Ȃ
+		no_grad ng;
+
+		// ڐpĩp[^ڐꍇ邽߁j
+		auto inputs = VariablePtrList();
+		for (size_t i = 0; i < xs.size(); i++) {
+			inputs.push_back(as_variable(xs[i]));
+			if (i < this->input_tangents.size()) inputs.back()->tangent = this->input_tangents[i];
+		}
+		auto outputs = this->func(inputs);
+
+		// ̓f[^̂܂ܕԂ֐蓾̂ŐVCX^Xɂ
+		auto ys = NdArrayPtrList();
+		auto tys = NdArrayPtrList();
+		for (const auto& o : outputs) {
+			ys.push_back(as_array(*o->data));
+			tys.push_back(o->tangent);
+		}
+		if (std::any_of(tys.cbegin(), tys.cend(), [](const NdArrayPtr& t) { return t != nullptr; })) {
+			this->output_tangents = tys;
+		}
+		return ys;
+	}
+	// t`d
+	VariablePtrList backward(const VariablePtrList& gys) override
+	{
+		// t`ďvZOt邩ǂ͌Ăяo̐ݒɏ]
+		bool create_graph = Config::get_instance().flags.enable_backprop;
+
+		// ̓f[^Vϐɒuď`dČvZ
+		// ڐpAwbZsxNgςȂǂ̓KɑΉ
+		auto xs = VariablePtrList();
+		for (const auto& i : this->inputs) {
+			xs.push_back(as_variable(i->data));
+			xs.back()->tangent = i->tangent;
+		}
+		auto ys = VariablePtrList();
+		auto y = VariablePtr();
+		{
+			UsingConfig with("enable_backprop", true);
+			ys = this->func(xs);
+
+			// o͂̏ꍇ͌zƂ̐ς̑aN_Ƃ
+			if (ys.size() == 1) {
+				y = ys[0];
+				y->grad = gys[0];
+			}
+			else {
+				for (size_t i = 0; i < ys.size(); i++) {
+					if (!gys[i]) continue;
+					auto t = sum(ys[i] * gys[i]);
+					y = y ? y + t : t;
+				}
+			}
+		}
+
+		// ČvZvZOtŋt`d
+		y->backward(false, create_graph);
+
+		// ̓f[^̌zԂigȂ͂ 0 Ƃj
+		auto gxs = VariablePtrList();
+		for (const auto& x : xs) {
+			if (x->grad) gxs.push_back(x->grad);
+			else gxs.push_back(as_variable(as_array(nc::zeros_like<data_t>(*x->data))));
+		}
+		return gxs;
+	}
+	// [h̔iڐ̓`dj
+	NdArrayPtrList jvp(const NdArrayPtrList& xs, const NdArrayPtrList& /*ys*/, const NdArrayPtrList& txs) override
+	{
+		// ڐ^͂ŏ`dČvZďo͂̐ڐ𓾂
+		no_grad ng;
+
+		auto inputs = VariablePtrList();
+		for (size_t i = 0; i < xs.size(); i++) {
+			inputs.push_back(as_variable(xs[i]));
+			inputs.back()->tangent = txs[i];
+		}
+		auto outputs = this->func(inputs);
+
+		auto tys = NdArrayPtrList();
+		for (const auto& o : outputs) {
+			tys.push_back(o->tangent);
+		}
+		return tys;
+	}
 };
 
 //----------------------------------
@@ -392,7 +752,7 @@ public:
 // sin
 inline VariablePtr sin(const VariablePtr& x)
 {
-	FunctionPtr f = std::make_shared<Sin>();
+	FunctionPtr f = make_node<Sin>();
 	VariablePtrList args = { x };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -405,7 +765,7 @@ inline VariablePtrList sin(const VariablePtrList& xs)
 // cos
 inline VariablePtr cos(const VariablePtr& x)
 {
-	FunctionPtr f = std::make_shared<Cos>();
+	FunctionPtr f = make_node<Cos>();
 	VariablePtrList args = { x };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -418,7 +778,7 @@ inline VariablePtrList cos(const VariablePtrList& xs)
 // tanh
 inline VariablePtr tanh(const VariablePtr& x)
 {
-	FunctionPtr f = std::make_shared<Tanh>();
+	FunctionPtr f = make_node<Tanh>();
 	VariablePtrList args = { x };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -431,7 +791,7 @@ inline VariablePtrList tanh(const VariablePtrList& xs)
 // exp
 inline VariablePtr exp(const VariablePtr& x)
 {
-	FunctionPtr f = std::make_shared<Exp>();
+	FunctionPtr f = make_node<Exp>();
 	VariablePtrList args = { x };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -448,7 +808,7 @@ inline VariablePtr reshape(const VariablePtr& x, const nc::Shape& shape)
 	if (x->data->shape() == shape) {
 		return as_variable(*x);
 	}
-	FunctionPtr f = std::make_shared<Reshape>(shape);
+	FunctionPtr f = make_node<Reshape>(shape);
 	VariablePtrList args = { x };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -461,7 +821,7 @@ inline VariablePtrList reshape(const VariablePtrList& xs, const nc::Shape& shape
 // transpose
 inline VariablePtr transpose(const VariablePtr& x)
 {
-	FunctionPtr f = std::make_shared<Transpose>();
+	FunctionPtr f = make_node<Transpose>();
 	VariablePtrList args = { x };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -474,7 +834,7 @@ inline VariablePtrList transpose(const VariablePtrList& xs)
 // sum
 inline VariablePtr sum(const VariablePtr& x, nc::Axis axis /*=nc::Axis::NONE*/)
 {
-	FunctionPtr f = std::make_shared<Sum>(axis);
+	FunctionPtr f = make_node<Sum>(axis);
 	VariablePtrList args = { x };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -491,7 +851,7 @@ inline VariablePtr broadcast_to(const VariablePtr& x, const nc::Shape& shape)
 	if (x->data->shape() == shape) {
 		return as_variable(*x);
 	}
-	FunctionPtr f = std::make_shared<BroadcastTo>(shape);
+	FunctionPtr f = make_node<BroadcastTo>(shape);
 	VariablePtrList args = { x };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -508,7 +868,7 @@ inline VariablePtr sum_to(const VariablePtr& x, const nc::Shape& shape)
 	if (x->data->shape() == shape) {
 		return as_variable(*x);
 	}
-	FunctionPtr f = std::make_shared<SumTo>(shape);
+	FunctionPtr f = make_node<SumTo>(shape);
 	VariablePtrList args = { x };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -521,7 +881,7 @@ inline VariablePtrList sum_to(const VariablePtrList& xs, const nc::Shape& shape)
 // matmul
 inline VariablePtr matmul(const VariablePtr& x, const VariablePtr& W)
 {
-	FunctionPtr f = std::make_shared<MatMul>();
+	FunctionPtr f = make_node<MatMul>();
 	VariablePtrList args = { x, W };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -534,7 +894,7 @@ inline VariablePtrList matmul(const VariablePtrList& xs)
 // linear
 inline VariablePtr linear(const VariablePtr& x, const VariablePtr& W, const VariablePtr& b /*=nullptr*/)
 {
-	FunctionPtr f = std::make_shared<Linear>();
+	FunctionPtr f = make_node<Linear>();
 	VariablePtrList args = { x, W, b };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -554,7 +914,7 @@ inline VariablePtr linear_simple(const VariablePtr& x, const VariablePtr& W, con
 	if (!b) return t;
 
 	auto y = t + b;
-	t->data = nullptr;	// t̃f[^͕svȂ̂ŏ
+	t->release_data();	// t̃f[^͋t`dŕsvȂ̂ŉ
 	return y;
 }
 inline VariablePtrList linear_simple(const VariablePtrList& xs)
@@ -568,7 +928,7 @@ inline VariablePtrList linear_simple(const VariablePtrList& xs)
 // sigmoid
 inline VariablePtr sigmoid(const VariablePtr& x)
 {
-	FunctionPtr f = std::make_shared<Sigmoid>();
+	FunctionPtr f = make_node<Sigmoid>();
 	VariablePtrList args = { x };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -581,7 +941,9 @@ inline VariablePtrList sigmoid(const VariablePtrList& xs)
 // sigmoid ȈՔ
 inline VariablePtr sigmoid_simple(const VariablePtr& x)
 {
-	auto y = 1.0 / (1.0 + exp(-x));
+	auto t = -x;
+	auto y = 1.0 / (1.0 + exp(t));
+	t->release_data();	// t̃f[^͋t`dŕsvȂ̂ŉ
 	return y;
 }
 inline VariablePtrList sigmoid_simple(const VariablePtrList& xs)
@@ -592,7 +954,7 @@ inline VariablePtrList sigmoid_simple(const VariablePtrList& xs)
 // mean_squared_error
 inline VariablePtr mean_squared_error(const VariablePtr& x0, const VariablePtr& x1)
 {
-	FunctionPtr f = std::make_shared<MeanSquaredError>();
+	FunctionPtr f = make_node<MeanSquaredError>();
 	VariablePtrList args = { x0, x1 };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -605,7 +967,7 @@ inline VariablePtrList mean_squared_error(const VariablePtrList& xs)
 // softmax
 inline VariablePtr softmax(const VariablePtr& x, nc::Axis axis /*=nc::Axis::ROW*/)
 {
-	FunctionPtr f = std::make_shared<Softmax>(axis);
+	FunctionPtr f = make_node<Softmax>(axis);
 	VariablePtrList args = { x };
 	auto ys = (*f)(args);
 	return ys[0];
@@ -627,4 +989,15 @@ inline VariablePtrList softmax_simple(const VariablePtrList& xs, nc::Axis axis)
 	return { softmax_simple(xs[0], axis) };
 }
 
+// checkpoint
+inline VariablePtrList checkpoint(const std::function<function_t>& func, const VariablePtrList& xs)
+{
+	FunctionPtr f = make_node<Checkpoint>(func);
+	return (*f)(xs);
+}
+inline VariablePtr checkpoint(const std::function<function_t>& func, const VariablePtr& x)
+{
+	return checkpoint(func, VariablePtrList({ x }))[0];
+}
+
 }	// namespace dz::functions
@@ -280,11 +280,12 @@ public:
 	}
 
 	// d݂̏
+	// ݂͌̃Xbh̗Xg[iUsingSeed ŃfƂɃV[hwłj
 	void init_W()
 	{
 		auto I = this->in_size;
 		auto O = this->out_size;
-		auto W_data = nc::random::randN<data_t>({ I, O }) * nc::sqrt<data_t>(1.0 / I);
+		auto W_data = RandomStream::get_instance().randn({ I, O }) * nc::sqrt<data_t>(1.0 / I);
 		this->prop("W")->data = as_array(W_data);
 	}
 
@@ -303,4 +304,24 @@ public:
 	}
 };
 
+// CNXi`FbN|Cgj
+// Ώۂ̃C F::checkpoint ŕ݁Ålt`dɍČvZ
+class Checkpoint : public Layer
+{
+public:
+	// RXgN^
+	Checkpoint(const LayerPtr& layer)
+	{
+		// Ώۂ̃CvpeBƂēo^ip[^̎WΏۂƂj
+		this->prop("layer") = layer;
+	}
+
+	// `d
+	virtual VariablePtrList forward(const VariablePtrList& xs) override
+	{
+		LayerPtr layer = this->prop("layer");
+		return F::checkpoint([layer](const VariablePtrList& xs) { return (*layer)(xs); }, xs);
+	}
+};
+
 }	// namespace dz::layers
@@ -0,0 +1,233 @@
+#pragma once
+
+#include "../dezero/dezero.hpp"
+
+namespace dz::memory
+{
+
+//----------------------------------
+// class
+//----------------------------------
+
+// obt@v[̓v
+struct PoolStats
+{
+	// LbV略o
+	size_t hits = 0;
+	// VKɊmۂ
+	size_t misses = 0;
+	// ԋpɃLbV̏𒴂邽߉
+	size_t releases = 0;
+	// gp̃oCg
+	size_t bytes_in_use = 0;
+	// LbVĂoCg
+	size_t bytes_cached = 0;
+	// mۍς݃oCgigp{LbVj̍ől
+	size_t high_watermark = 0;
+	// gp̃oCg̍ől
+	size_t peak_in_use = 0;
+};
+
+// obt@v[NX
+// wK[vł͖񓯂`̃e\mہE邽߁Aꂽobt@TCYNXƂɃLbVčėp
+// LbV̓V[hɕAXbhƂɌ܂V[hgi̋t`dȂǂłP̃bNɏWȂ߁j
+// ԋpꂽobt@͕ԋpXbh̃V[hɃLbVBLbV̍vicache_limitj𒴂镪͉
+class BufferPool
+{
+public:
+	// ACgiSIMD pj
+	static constexpr size_t alignment = 64;
+	// V[h̐
+	static constexpr size_t num_shards = 16;
+	// LbV̏̊lioCgj
+	static constexpr size_t default_cache_limit = size_t(1) << 30;
+
+private:
+	// V[hiLbVC𕪂j
+	struct alignas(64) Shard
+	{
+		// TCYNXƂ̋󂫃obt@
+		std::unordered_map<size_t, std::vector<void*>> free_lists;
+		// oEVKmہẺ
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t releases = 0;
+		// r
+		mutable std::mutex mtx;
+	};
+
+	// V[h
+	std::array<Shard, num_shards> shards;
+	// gpELbVĂoCgƁAꂼ̍ől
+	// V[h܂ŊmہEԋp邽߁Av[ŜŐ
+	std::atomic<size_t> bytes_in_use;
+	std::atomic<size_t> bytes_cached;
+	std::atomic<size_t> high_watermark;
+	std::atomic<size_t> peak_in_use;
+	// LbV̏ioCgj
+	std::atomic<size_t> cache_limit;
+
+	// RXgN^
+	BufferPool() :
+		bytes_in_use(0),
+		bytes_cached(0),
+		high_watermark(0),
+		peak_in_use(0),
+		cache_limit(default_cache_limit)
+	{}
+
+public:
+	// Rs[/[us
+	BufferPool(const BufferPool&) = delete;
+	BufferPool(BufferPool&&) = delete;
+	BufferPool& operator=(const BufferPool&) = delete;
+	BufferPool& operator=(BufferPool&&) = delete;
+
+	// CX^X擾
+	// ÓIIuWFNg̃fXgN^obt@ԋpꂤ邽߁ACX^X͔jȂ
+	static BufferPool& get_instance() {
+		static BufferPool* instance = new BufferPool();
+		return *instance;
+	}
+
+	// TCYNX߂
+	// 4KB ܂ł͂Qׂ̂Aȏ͂Qׂ̂SPʂɐ؂グiʂ͍ő25%j
+	static size_t size_class(size_t bytes)
+	{
+		size_t c = alignment;
+		while (c < bytes && c < 4096) c <<= 1;
+		if (c >= bytes) return c;
+
+		while (c < bytes) c <<= 1;
+		auto step = c >> 3;
+		auto s = c >> 1;
+		while (s < bytes) s += step;
+		return s;
+	}
+
+	// LbV̏ݒioCgj
+	// ݂̃LbV𒴂Ă trim 
+	void set_cache_limit(size_t bytes)
+	{
+		this->cache_limit = bytes;
+		if (this->bytes_cached.load(std::memory_order_relaxed) > bytes) this->trim();
+	}
+	size_t get_cache_limit() const { return this->cache_limit; }
+
+	// obt@m
+	void* allocate(size_t bytes)
+	{
+		if (bytes == 0) return nullptr;
+		auto c = size_class(bytes);
+		auto& shard = this->current_shard();
+
+		void* p = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(shard.mtx);
+			auto& list = shard.free_lists[c];
+			if (!list.empty()) {
+				// LbV略o
+				p = list.back();
+				list.pop_back();
+				shard.hits++;
+			}
+			else {
+				shard.misses++;
+			}
+		}
+		if (p) {
+			this->bytes_cached.fetch_sub(c, std::memory_order_relaxed);
+		}
+		else {
+			// VKɊm
+			p = ::operator new(c, std::align_val_t(alignment));
+		}
+		auto in_use = this->bytes_in_use.fetch_add(c, std::memory_order_relaxed) + c;
+		update_max(this->peak_in_use, in_use);
+		update_max(this->high_watermark, in_use + this->bytes_cached.load(std::memory_order_relaxed));
+		return p;
+	}
+
+	// obt@ԋp
+	void deallocate(void* p, size_t bytes)
+	{
+		if (!p) return;
+		auto c = size_class(bytes);
+		auto& shard = this->current_shard();
+		this->bytes_in_use.fetch_sub(c, std::memory_order_relaxed);
+
+		// LbV̏𒴂镪͉
+		if (this->bytes_cached.fetch_add(c, std::memory_order_relaxed) + c > this->cache_limit.load(std::memory_order_relaxed)) {
+			this->bytes_cached.fetch_sub(c, std::memory_order_relaxed);
+			::operator delete(p, std::align_val_t(alignment));
+			std::lock_guard<std::mutex> lock(shard.mtx);
+			shard.releases++;
+			return;
+		}
+		std::lock_guard<std::mutex> lock(shard.mtx);
+		shard.free_lists[c].push_back(p);
+	}
+
+	// LbVĂobt@
+	void trim()
+	{
+		for (auto& shard : this->shards) {
+			std::lock_guard<std::mutex> lock(shard.mtx);
+			for (auto& kv : shard.free_lists) {
+				for (auto p : kv.second) {
+					::operator delete(p, std::align_val_t(alignment));
+				}
+				this->bytes_cached.fetch_sub(kv.first * kv.second.size(), std::memory_order_relaxed);
+				kv.second.clear();
+			}
+		}
+	}
+
+	// v擾
+	PoolStats statistics() const
+	{
+		PoolStats stats;
+		for (auto& shard : this->shards) {
+			std::lock_guard<std::mutex> lock(shard.mtx);
+			stats.hits += shard.hits;
+			stats.misses += shard.misses;
+			stats.releases += shard.releases;
+		}
+		stats.bytes_in_use = this->bytes_in_use;
+		stats.bytes_cached = this->bytes_cached;
+		stats.high_watermark = this->high_watermark;
+		stats.peak_in_use = this->peak_in_use;
+		return stats;
+	}
+
+	// vZbgigpʂ͕ێ܂܉񐔂ƍől̂݃NAj
+	void reset_statistics()
+	{
+		for (auto& shard : this->shards) {
+			std::lock_guard<std::mutex> lock(shard.mtx);
+			shard.hits = 0;
+			shard.misses = 0;
+			shard.releases = 0;
+		}
+		this->high_watermark = this->bytes_in_use + this->bytes_cached;
+		this->peak_in_use = this->bytes_in_use.load();
+	}
+
+private:
+	// ݂̃Xbh̃V[hiXbhƂɏɊ蓖Ăj
+	Shard& current_shard()
+	{
+		static std::atomic<size_t> next(0);
+		static thread_local size_t index = next.fetch_add(1, std::memory_order_relaxed) % num_shards;
+		return this->shards[index];
+	}
+
+	// őlXV
+	static void update_max(std::atomic<size_t>& max, size_t value)
+	{
+		auto current = max.load(std::memory_order_relaxed);
+		while (current < value && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+	}
+};
+
+}	// namespace dz::memory
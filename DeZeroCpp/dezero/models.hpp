@@ -31,11 +31,15 @@ private:
 	std::vector<L::LayerPtr> layers;
 	// ֐
 	std::function<F::function_t> activation;
+	// `FbN|Cg̊Ԋui0 ȂgpȂj
+	size_t checkpoint_interval;
 
 public:
 	// RXgN^
-	MLP(std::vector<int> fc_output_sizes, F::function_t* activation = F::sigmoid) :
-		activation(activation)
+	// checkpoint_interval w肷ƁÃCƂ F::checkpoint ŕŊlt`dɍČvZ
+	MLP(std::vector<int> fc_output_sizes, F::function_t* activation = F::sigmoid, size_t checkpoint_interval = 0) :
+		activation(activation),
+		checkpoint_interval(checkpoint_interval)
 	{
 		int i = 0;
 		for (auto out_size : fc_output_sizes) {
@@ -53,16 +57,41 @@ public:
 	// `d
 	VariablePtrList forward(const VariablePtrList& xs) override
 	{
-		// Ō̂PÕC܂
+		// `FbN|CggpȂꍇ
+		if (this->checkpoint_interval == 0) {
+			return forward_range(this->layers, this->activation, true, xs);
+		}
+
+		// w̃CƂɃ`FbN|Cgŕ
+		// ČvZ̊֐͌vZOtɕێ MLP 蒷邽߁Athis ł͂ȂԂ̃CƊ֐ێ
 		auto xs_tmp = xs;
-		for (auto iter = this->layers.begin(); iter != this->layers.end() - 1; iter++) {
-			auto& l = **iter;
-			xs_tmp = this->activation(l(xs_tmp));
+		for (size_t first = 0; first < this->layers.size(); first += this->checkpoint_interval) {
+			auto last = std::min(first + this->checkpoint_interval, this->layers.size());
+			auto layers = std::vector<L::LayerPtr>(this->layers.begin() + first, this->layers.begin() + last);
+			auto activation = this->activation;
+			auto has_output = last == this->layers.size();
+			auto func = [layers, activation, has_output](const VariablePtrList& xs) { return forward_range(layers, activation, has_output, xs); };
+			xs_tmp = F::checkpoint(func, xs_tmp);
 		}
+		return xs_tmp;
+	}
+
+private:
+	// C̗̏`d
+	// has_output  true ȂŌ̃Co͑wƂi֐ʂȂj
+	static VariablePtrList forward_range(const std::vector<L::LayerPtr>& layers, const std::function<F::function_t>& activation, bool has_output, const VariablePtrList& xs)
+	{
+		auto xs_tmp = xs;
+		for (size_t i = 0; i < layers.size(); i++) {
+			auto& l = *layers[i];
+			xs_tmp = l(xs_tmp);
 
-		// Ō̃C
-		auto &l = *this->layers.back();
-		return l(xs_tmp);
+			// o͑wȊO͊֐ʂ
+			if (!has_output || i != layers.size() - 1) {
+				xs_tmp = activation(xs_tmp);
+			}
+		}
+		return xs_tmp;
 	}
 };
 
@@ -0,0 +1,370 @@
+#pragma once
+
+#include "../dezero/dezero.hpp"
+
+namespace dz::parallel
+{
+
+//----------------------------------
+// class
+//----------------------------------
+
+// Xbhv[NXi[NXeB[Oj
+// [J[ƂɃ^XNL[Ag̃L[ɂȂ瑼̃[J[̃L[瓐Ŏs
+class ThreadPool
+{
+public:
+	// ^XŇ^
+	using task_t = std::function<void()>;
+	// [J[̏
+	static constexpr size_t max_threads = 256;
+
+private:
+	// [J[Ƃ̃^XNL[
+	struct Queue
+	{
+		std::deque<task_t> tasks;
+		std::mutex mtx;
+	};
+
+	// ^XNL[i擪 num_queues Lj
+	// [J[̒ǉ̃XbhbNȂŎQƂł悤Ä͌ŒŊmۂĂ
+	std::array<std::unique_ptr<Queue>, max_threads> queues;
+	std::atomic<size_t> num_queues;
+	// [J[Xbh
+	std::vector<std::thread> threads;
+	// [J[̒ǉ̔r
+	std::mutex grow_mtx;
+	// s̃^XN
+	std::atomic<size_t> pending;
+	// L[̏ʒu
+	std::atomic<size_t> next_queue;
+	// ҋ@p
+	std::mutex wake_mtx;
+	std::condition_variable wake_cv;
+	// ~v
+	bool stop;
+
+	// s̃[J[ԍi[J[ȊÕXbh -1j
+	static int& worker_index() {
+		static thread_local int index = -1;
+		return index;
+	}
+	// ^XNs
+	static bool& task_flag() {
+		static thread_local bool flag = false;
+		return flag;
+	}
+
+public:
+	// RXgN^
+	ThreadPool(size_t num_threads) :
+		num_queues(0),
+		pending(0),
+		next_queue(0),
+		stop(false)
+	{
+		this->reserve(std::max<size_t>(num_threads, 1));
+	}
+
+	// fXgN^
+	virtual ~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->wake_mtx);
+			this->stop = true;
+		}
+		this->wake_cv.notify_all();
+		std::lock_guard<std::mutex> lock(this->grow_mtx);
+		for (auto& t : this->threads) {
+			t.join();
+		}
+	}
+
+	// Rs[/[us
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool(ThreadPool&&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	ThreadPool& operator=(ThreadPool&&) = delete;
+
+	// CX^X擾
+	// ÓIIuWFNg̔j̖邽߁ACX^X͔jȂ
+	static ThreadPool& get_instance() {
+		static ThreadPool* instance = new ThreadPool(default_num_threads());
+		return *instance;
+	}
+
+	// ̃Xbh
+	// ϐ DEZERO_NUM_THREADS ΂̒lAȂ΃n[hEFÃXbhƂ
+	static size_t default_num_threads()
+	{
+		static const size_t n = []() {
+			int v = 0;
+#ifdef _MSC_VER
+			char* env = nullptr;
+			size_t len = 0;
+			if (_dupenv_s(&env, &len, "DEZERO_NUM_THREADS") == 0 && env) {
+				v = std::atoi(env);
+				free(env);
+			}
+#else
+			if (auto env = std::getenv("DEZERO_NUM_THREADS")) v = std::atoi(env);
+#endif	// #ifdef _MSC_VER
+			return v > 0 ? static_cast<size_t>(v) : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+		}();
+		return n;
+	}
+
+	// ݂̃XbhŃ^XNs
+	static bool in_task() { return task_flag(); }
+
+	// [J[Xbh
+	size_t size() const { return this->num_queues.load(std::memory_order_acquire); }
+
+	// [J[Xbh num_threads ȏɑ₷i炷Ƃ͂Ȃj
+	void reserve(size_t num_threads)
+	{
+		num_threads = std::min(num_threads, max_threads);
+		std::lock_guard<std::mutex> lock(this->grow_mtx);
+		for (auto i = this->size(); i < num_threads; i++) {
+			// L[pӂĂJǍɃ[J[N
+			this->queues[i] = std::make_unique<Queue>();
+			this->num_queues.store(i + 1, std::memory_order_release);
+			this->threads.emplace_back([this, i]() { this->worker_loop(static_cast<int>(i)); });
+		}
+	}
+
+	// ^XN𓊓
+	void submit(task_t task)
+	{
+		// [J[g^XN͎g̃L[ցAȊO͏񂵂ĐU蕪
+		auto index = worker_index();
+		auto q = index >= 0 ? static_cast<size_t>(index) : this->next_queue++ % this->size();
+		{
+			// oŌɂȂȂ悤AL[֐ςޑOɐ
+			std::lock_guard<std::mutex> lock(this->wake_mtx);
+			this->pending++;
+		}
+		{
+			std::lock_guard<std::mutex> lock(this->queues[q]->mtx);
+			this->queues[q]->tasks.push_back(std::move(task));
+		}
+		this->wake_cv.notify_one();
+	}
+
+	// ^XNPoĎsi^XN falsej
+	// ҋ@̃XbhĂԂƂŁA҂Ԃɂ^XNł
+	bool run_one()
+	{
+		task_t task;
+		if (!this->pop(task)) return false;
+		this->pending--;
+		ScopedTask scope;
+		task();
+		return true;
+	}
+
+	// ^XNs̖ڈiXR[v𔲂ƌɖ߂j
+	class ScopedTask
+	{
+	private:
+		bool old_flag;
+	public:
+		ScopedTask() : old_flag(task_flag()) { task_flag() = true; }
+		~ScopedTask() { task_flag() = this->old_flag; }
+	};
+
+private:
+	// ^XNo
+	bool pop(task_t& task)
+	{
+		auto index = worker_index();
+		auto n = this->size();
+		auto first = index >= 0 ? static_cast<size_t>(index) : 0;
+
+		for (size_t k = 0; k < n; k++) {
+			auto q = (first + k) % n;
+			std::lock_guard<std::mutex> lock(this->queues[q]->mtx);
+			auto& tasks = this->queues[q]->tasks;
+			if (tasks.empty()) continue;
+
+			// g̃L[͌납iLIFOjÃL[͑OiFIFOj
+			if (index >= 0 && q == first) {
+				task = std::move(tasks.back());
+				tasks.pop_back();
+			}
+			else {
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+			return true;
+		}
+		return false;
+	}
+
+	// [J[Xbh̏
+	void worker_loop(int index)
+	{
+		worker_index() = index;
+		while (true) {
+			if (this->run_one()) continue;
+
+			std::unique_lock<std::mutex> lock(this->wake_mtx);
+			this->wake_cv.wait(lock, [this]() { return this->stop || this->pending > 0; });
+			if (this->stop) break;
+		}
+	}
+};
+
+// ^XNO[vNX
+// ^XNׂĊ܂őҋ@
+// ҋ@̓^XNAł^XNԂ΂炭O[v̏ϐŃubN
+class TaskGroup
+{
+private:
+	// ubN܂łɋU
+	static constexpr size_t spin_count = 256;
+
+	// Xbhv[
+	ThreadPool& pool;
+	// ̃^XN
+	std::atomic<size_t> count;
+	// ҋ@pi^XN̊Ɠʒmj
+	std::mutex mtx;
+	std::condition_variable cv;
+	bool submitted;
+	// ^XNŔO
+	std::exception_ptr error;
+	std::mutex error_mtx;
+
+public:
+	// RXgN^
+	TaskGroup(ThreadPool& pool = ThreadPool::get_instance()) :
+		pool(pool),
+		count(0),
+		submitted(false)
+	{}
+
+	// fXgN^
+	virtual ~TaskGroup()
+	{
+		// s̃^XNc܂ܔjȂ悤ɂ
+		this->wait_all();
+	}
+
+	// ^XN𓊓
+	void run(const ThreadPool::task_t& task)
+	{
+		this->count++;
+		this->pool.submit([this, task]() {
+			try {
+				task();
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(this->error_mtx);
+				if (!this->error) this->error = std::current_exception();
+			}
+			// ҋ@ƓbN̒œǂނ悤A̓bNČ炷
+			std::lock_guard<std::mutex> lock(this->mtx);
+			if (--this->count == 0) this->cv.notify_all();
+		});
+		// ubN̑ҋ@ɂi^XN̒瓯O[v֓ꍇȂǁj
+		{
+			std::lock_guard<std::mutex> lock(this->mtx);
+			this->submitted = true;
+		}
+		this->cv.notify_all();
+	}
+
+	// S^XN̊ҋ@iҋ@^XNj
+	void wait()
+	{
+		this->wait_all();
+		if (this->error) {
+			auto e = this->error;
+			this->error = nullptr;
+			std::rethrow_exception(e);
+		}
+	}
+
+private:
+	// S^XN̊ҋ@
+	void wait_all()
+	{
+		size_t idle = 0;
+		while (this->count > 0) {
+			if (this->pool.run_one()) {
+				idle = 0;
+				continue;
+			}
+			if (++idle < spin_count) {
+				std::this_thread::yield();
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(this->mtx);
+			this->cv.wait(lock, [this]() { return this->count == 0 || this->submitted; });
+			this->submitted = false;
+			idle = 0;
+		}
+		// Ō̃^XNbN𗣂܂ő҂ǐO[vjĂGȂ悤ɂj
+		std::lock_guard<std::mutex> lock(this->mtx);
+	}
+};
+
+//----------------------------------
+// function
+//----------------------------------
+
+// P^XN̊̍ŏvf
+constexpr size_t default_grain = 1 << 14;
+
+// 񏈗ɎgXbhiĂяoXbh܂ށj
+inline std::atomic<size_t>& num_threads_value()
+{
+	static std::atomic<size_t> n(ThreadPool::default_num_threads());
+	return n;
+}
+inline size_t num_threads()
+{
+	return num_threads_value();
+}
+// Xbhv[̃[J[ȂΑ₷i[J[͌炳ȂB ThreadPool::max_threads{Pj
+inline void set_num_threads(size_t n)
+{
+	n = std::min(std::max<size_t>(n, 1), ThreadPool::max_threads + 1);
+	ThreadPool::get_instance().reserve(n - 1);
+	num_threads_value() = n;
+}
+
+// ͈ [first, last) 𕪊ăXbhv[ŕɏ
+// func ͕͈ (first, last) 󂯎B grainiP^XN̍ŏvfjƃXbh猈߂
+// ^XN̒Ă΂ꂽꍇiqj́AXbh̉ߏȊ蓖Ă邽߂̃XbhŒ
+template<typename F>
+inline void parallel_for(size_t first, size_t last, size_t grain, const F& func)
+{
+	if (first >= last) return;
+	auto n = last - first;
+	grain = std::max<size_t>(grain, 1);
+
+	auto& pool = ThreadPool::get_instance();
+	auto chunks = std::min({ (n + grain - 1) / grain, num_threads(), pool.size() + 1 });
+	if (chunks <= 1 || ThreadPool::in_task()) {
+		func(first, last);
+		return;
+	}
+
+	// 擪ȊO͈͂̕^XNƂēA擪͎gŏ
+	auto step = (n + chunks - 1) / chunks;
+	TaskGroup group(pool);
+	for (auto begin = first + step; begin < last; begin += step) {
+		auto end = std::min(begin + step, last);
+		group.run([&func, begin, end]() { func(begin, end); });
+	}
+	{
+		ThreadPool::ScopedTask scope;
+		func(first, first + step);
+	}
+	group.wait();
+}
+
+}	// namespace dz::parallel
@@ -0,0 +1,348 @@
+#pragma once
+
+#include "../dezero/dezero.hpp"
+
+namespace dz
+{
+
+//----------------------------------
+// type
+//----------------------------------
+
+// QƃJEǧ^
+// DEZERO_SINGLE_THREAD `ƃJEgAg~bNɂiXbhv[̋t`dƕpȂƁj
+#ifdef DEZERO_SINGLE_THREAD
+using ref_count_t = size_t;
+#else
+using ref_count_t = std::atomic<size_t>;
+#endif	// #ifdef DEZERO_SINGLE_THREAD
+
+// vZXɃXbhP
+// glibc  __libc_single_threaded gistd::shared_ptr ƓjBgȂł͏ false
+// xXbh true ɂ͖߂Ȃ߁Atrue ̊Ԃ̔Ag~bNȍXV͌ォꂽXbh
+inline bool is_single_threaded()
+{
+#ifdef __GLIBC__
+#if __has_include(<sys/single_threaded.h>)
+	return ::__libc_single_threaded;
+#else
+	return false;
+#endif	// #if __has_include(<sys/single_threaded.h>)
+#else
+	return false;
+#endif	// #ifdef __GLIBC__
+}
+
+// QƃJEg𑝂₷
+// ɎQƂĂXbh₷߁At͕svirelaxedj
+// XbhP̊Ԃ̓Ag~bNȓǂݏύXilock ߁jAǂݍ݂Ə݂ɕ
+inline void ref_increment(ref_count_t& count)
+{
+#ifdef DEZERO_SINGLE_THREAD
+	++count;
+#else
+	if (is_single_threaded()) {
+		count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		return;
+	}
+	count.fetch_add(1, std::memory_order_relaxed);
+#endif	// #ifdef DEZERO_SINGLE_THREAD
+}
+
+// QƃJEg炵A炵̒lԂ
+// 0 ɂȂXbhjOɁÃXbĥ܂ł݂̏悤ɂiacq_relj
+inline size_t ref_decrement(ref_count_t& count)
+{
+#ifdef DEZERO_SINGLE_THREAD
+	return --count;
+#else
+	if (is_single_threaded()) {
+		auto n = count.load(std::memory_order_relaxed) - 1;
+		count.store(n, std::memory_order_relaxed);
+		return n;
+	}
+	return count.fetch_sub(1, std::memory_order_acq_rel) - 1;
+#endif	// #ifdef DEZERO_SINGLE_THREAD
+}
+
+//----------------------------------
+// class
+//----------------------------------
+
+// QƃJEg̊NXiN^j
+// QƃJEgIuWFNgg߁Astd::shared_ptr ̂悤ȊǗubN̊mۂƊԐڎQƂsv
+// QƂ 0 ɂȂƃfXgN^ĂсAQƂ 0 ɂȂ_ŗ̈istd::make_shared Ɠj
+// QƃJEg̓fXgN^̌QƂQƂ邽߁Aoł͂ȂIuWFNg̗̈ɕʓr\zĔjȂ
+class RefCounted
+{
+public:
+	// QƃJEg
+	struct Counts
+	{
+		// QƂ̐
+		ref_count_t strong;
+		// QƂ̐iQƂcĂԂ͂̕Ƃ +1j
+		ref_count_t weak;
+		// ̈iQƂ 0 ɂȂ_Őݒ肷j
+		void* memory;
+
+		Counts() :
+			strong(0),
+			weak(1),
+			memory(nullptr)
+		{}
+	};
+
+private:
+	// QƃJEg̗̈
+	alignas(Counts) mutable unsigned char counts_storage[sizeof(Counts)];
+
+public:
+	// RXgN^
+	RefCounted()
+	{
+		new (this->counts_storage) Counts();
+	}
+	// Rs[RXgN^iQƃJEg͈pȂj
+	RefCounted(const RefCounted&)
+	{
+		new (this->counts_storage) Counts();
+	}
+	RefCounted& operator=(const RefCounted&) { return *this; }
+
+	// fXgN^
+	virtual ~RefCounted() {}
+
+	// QƃJEg擾
+	Counts& counts() const
+	{
+		return *std::launder(reinterpret_cast<Counts*>(this->counts_storage));
+	}
+
+	// QƃJEg𑝂₷
+	void add_ref() const
+	{
+		ref_increment(this->counts().strong);
+	}
+
+	// QƃJEg炵A0 ɂȂΔj
+	// 炷̏ꍇ唼Ȃ̂ŁAj͕̏ʂ̊֐ɂĂ̊֐CCWJ₷
+	void release() const
+	{
+		if (ref_decrement(this->counts().strong) != 0) return;
+		this->destroy();
+	}
+
+private:
+	// jifXgN^ĂсAQƂ̎̕QƂOj
+	void destroy() const
+	{
+		auto& c = this->counts();
+		auto self = const_cast<RefCounted*>(this);
+		// ̈ make_ref  new ŊmۂhNX̐擪
+		c.memory = dynamic_cast<void*>(self);
+		self->~RefCounted();
+		release_weak(c);
+	}
+
+public:
+	// QƂ𑝂₷
+	static void add_weak(Counts& c)
+	{
+		ref_increment(c.weak);
+	}
+
+	// QƂ炵A0 ɂȂΗ̈
+	static void release_weak(Counts& c)
+	{
+		if (ref_decrement(c.weak) != 0) return;
+		::operator delete(c.memory);
+	}
+
+	// QƃJEg 0 łȂΑ₷iQƂ̕pBj̃IuWFNg͕Ȃj
+	static bool try_add_ref(Counts& c)
+	{
+#ifdef DEZERO_SINGLE_THREAD
+		if (c.strong == 0) return false;
+		++c.strong;
+		return true;
+#else
+		auto n = c.strong.load(std::memory_order_relaxed);
+		if (is_single_threaded()) {
+			if (n == 0) return false;
+			c.strong.store(n + 1, std::memory_order_relaxed);
+			return true;
+		}
+		while (n != 0) {
+			if (c.strong.compare_exchange_weak(n, n + 1, std::memory_order_relaxed)) return true;
+		}
+		return false;
+#endif	// #ifdef DEZERO_SINGLE_THREAD
+	}
+
+	// QƃJEg
+	size_t use_count() const { return this->counts().strong; }
+};
+
+// N^̎QƃJEgt|C^NX
+// std::shared_ptr Ɠgł悤AvȃoƉZq낦
+template<typename T>
+class Ref
+{
+private:
+	// QƐ
+	T* p;
+
+	template<typename U> friend class Ref;
+
+public:
+	// vf̌^
+	using element_type = T;
+
+	// RXgN^
+	Ref() : p(nullptr) {}
+	Ref(std::nullptr_t) : p(nullptr) {}
+	explicit Ref(T* p) : p(p) { if (this->p) this->p->add_ref(); }
+	Ref(const Ref& other) : p(other.p) { if (this->p) this->p->add_ref(); }
+	Ref(Ref&& other) noexcept : p(other.p) { other.p = nullptr; }
+	template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+	Ref(const Ref<U>& other) : p(other.p) { if (this->p) this->p->add_ref(); }
+	template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+	Ref(Ref<U>&& other) noexcept : p(other.p) { other.p = nullptr; }
+
+	// fXgN^
+	~Ref() { if (this->p) this->p->release(); }
+
+	// Zq
+	Ref& operator=(const Ref& other)
+	{
+		Ref(other).swap(*this);
+		return *this;
+	}
+	Ref& operator=(Ref&& other) noexcept
+	{
+		Ref(std::move(other)).swap(*this);
+		return *this;
+	}
+	Ref& operator=(std::nullptr_t)
+	{
+		this->reset();
+		return *this;
+	}
+
+	// QƐ
+	void swap(Ref& other) noexcept { std::swap(this->p, other.p); }
+	// QƂ
+	void reset() { Ref().swap(*this); }
+
+	// QƐ̎擾
+	T* get() const { return this->p; }
+	T& operator*() const { return *this->p; }
+	T* operator->() const { return this->p; }
+	explicit operator bool() const { return this->p != nullptr; }
+	size_t use_count() const { return this->p ? this->p->use_count() : 0; }
+
+	// QƃJEg𑝂₳ɐ̃|C^琶iQƂ̕pj
+	static Ref adopt(T* p)
+	{
+		Ref r;
+		r.p = p;
+		return r;
+	}
+};
+
+// rZq
+template<typename T, typename U> bool operator==(const Ref<T>& lhs, const Ref<U>& rhs) { return lhs.get() == rhs.get(); }
+template<typename T, typename U> bool operator!=(const Ref<T>& lhs, const Ref<U>& rhs) { return lhs.get() != rhs.get(); }
+template<typename T, typename U> bool operator<(const Ref<T>& lhs, const Ref<U>& rhs) { return std::less<const void*>()(lhs.get(), rhs.get()); }
+template<typename T> bool operator==(const Ref<T>& lhs, std::nullptr_t) { return !lhs; }
+template<typename T> bool operator!=(const Ref<T>& lhs, std::nullptr_t) { return static_cast<bool>(lhs); }
+
+// N^̎QƃNX
+// QƐ̎ɂ͉eAlock() ŐĂ Ref 擾ł
+// QƐ̃fXgN^̌QƃJEg̗͎̈c邽߁Alock() ͎QƃJEg̔rōς
+template<typename T>
+class WeakRef
+{
+private:
+	// QƐ
+	T* p;
+	// QƐ̎QƃJEg
+	RefCounted::Counts* c;
+
+public:
+	// RXgN^
+	WeakRef() : p(nullptr), c(nullptr) {}
+	WeakRef(const Ref<T>& r) : p(r.get()), c(r ? &r->counts() : nullptr) { if (this->c) RefCounted::add_weak(*this->c); }
+	WeakRef(const WeakRef& other) : p(other.p), c(other.c) { if (this->c) RefCounted::add_weak(*this->c); }
+	WeakRef(WeakRef&& other) noexcept : p(other.p), c(other.c) { other.p = nullptr; other.c = nullptr; }
+
+	// fXgN^
+	~WeakRef() { if (this->c) RefCounted::release_weak(*this->c); }
+
+	// Zq
+	WeakRef& operator=(WeakRef other) noexcept
+	{
+		std::swap(this->p, other.p);
+		std::swap(this->c, other.c);
+		return *this;
+	}
+
+	// QƐ擾ijς݂Ȃ nullptrj
+	Ref<T> lock() const
+	{
+		if (!this->c || !RefCounted::try_add_ref(*this->c)) return Ref<T>();
+		return Ref<T>::adopt(this->p);
+	}
+	// QƐ悪jς݂
+	bool expired() const { return !this->c || this->c->strong == 0; }
+};
+
+// gւ̎QƂ擾łNXistd::enable_shared_from_this ɑj
+// Ref LĂȂiQƃJEg 0 ́jIuWFNgł std::bad_weak_ptr 𑗏o
+// iRXgN^fXgN^̒ARef g킸ɐIuWFNgȂǁBQƂƔjdɂȂ邽߁j
+template<typename T>
+class EnableRefFromThis : public RefCounted
+{
+public:
+	Ref<T> shared_from_this()
+	{
+		if (this->use_count() == 0) throw std::bad_weak_ptr();
+		return Ref<T>(static_cast<T*>(this));
+	}
+	Ref<const T> shared_from_this() const
+	{
+		if (this->use_count() == 0) throw std::bad_weak_ptr();
+		return Ref<const T>(static_cast<const T*>(this));
+	}
+};
+
+//----------------------------------
+// function
+//----------------------------------
+
+// Ref ֐istd::make_shared ɑj
+template<typename T, typename... Args>
+inline Ref<T> make_ref(Args&&... args)
+{
+	return Ref<T>(new T(std::forward<Args>(args)...));
+}
+
+// Ref ̓ILXgistd::dynamic_pointer_cast ɑj
+template<typename T, typename U>
+inline Ref<T> dynamic_pointer_cast(const Ref<U>& r)
+{
+	return Ref<T>(dynamic_cast<T*>(r.get()));
+}
+
+}	// namespace dz
+
+// nbViunordered ReĩL[pj
+namespace std
+{
+template<typename T>
+struct hash<dz::Ref<T>>
+{
+	size_t operator()(const dz::Ref<T>& r) const { return std::hash<const void*>()(r.get()); }
+};
+}	// namespace std
@@ -0,0 +1,309 @@
+#pragma once
+
+#include "../dezero/dezero.hpp"
+
+namespace dz
+{
+
+//----------------------------------
+// class
+//----------------------------------
+
+// vfȂԂ̓q[vmۂȂϒzNX
+// N ܂ł͓̃obt@Ɋi[Aꍇ̂݃q[vɊmۂ
+// ֐̓o͂͂P`QقƂǂ̂߁AZƂ std::vector ̊mۂ𖳂̂Ɏg
+template<typename T, size_t N>
+class SmallVector
+{
+public:
+	// ^
+	using value_type = T;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using pointer = T*;
+	using const_pointer = const T*;
+	using iterator = T*;
+	using const_iterator = const T*;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+	// ̃obt@
+	alignas(T) unsigned char inline_buf[sizeof(T) * N];
+	// vf̐擪
+	T* p;
+	// vf
+	size_t n;
+	// e
+	size_t cap;
+
+	// ̃obt@gp
+	bool is_inline() const { return this->p == inline_ptr(); }
+	T* inline_ptr() { return reinterpret_cast<T*>(this->inline_buf); }
+	const T* inline_ptr() const { return reinterpret_cast<const T*>(this->inline_buf); }
+
+	// ̈ivf͔jς݂ł邱Ɓj
+	void free_storage()
+	{
+		if (!is_inline()) {
+			::operator delete(this->p);
+		}
+		this->p = inline_ptr();
+		this->cap = N;
+	}
+
+	// eʂg
+	void grow(size_t min_cap)
+	{
+		auto new_cap = std::max(min_cap, this->cap * 2);
+		auto new_p = static_cast<T*>(::operator new(sizeof(T) * new_cap));
+		for (size_t i = 0; i < this->n; i++) {
+			new (new_p + i) T(std::move(this->p[i]));
+			this->p[i].~T();
+		}
+		free_storage();
+		this->p = new_p;
+		this->cap = new_cap;
+	}
+
+	// ̃CX^XvfDig͋ł邱Ɓj
+	void steal(SmallVector& other)
+	{
+		if (other.is_inline()) {
+			for (size_t i = 0; i < other.n; i++) {
+				new (this->p + i) T(std::move(other.p[i]));
+				other.p[i].~T();
+			}
+		}
+		else {
+			this->p = other.p;
+			this->cap = other.cap;
+			other.p = other.inline_ptr();
+			other.cap = N;
+		}
+		this->n = other.n;
+		other.n = 0;
+	}
+
+public:
+	// RXgN^
+	SmallVector() :
+		p(inline_ptr()),
+		n(0),
+		cap(N)
+	{}
+	explicit SmallVector(size_t count) :
+		SmallVector()
+	{
+		this->resize(count);
+	}
+	SmallVector(size_t count, const T& value) :
+		SmallVector()
+	{
+		this->resize(count, value);
+	}
+	SmallVector(std::initializer_list<T> init) :
+		SmallVector(init.begin(), init.end())
+	{}
+	template<typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+	SmallVector(InputIt first, InputIt last) :
+		SmallVector()
+	{
+		for (; first != last; ++first) {
+			this->emplace_back(*first);
+		}
+	}
+	SmallVector(const SmallVector& other) :
+		SmallVector(other.begin(), other.end())
+	{}
+	SmallVector(SmallVector&& other) noexcept :
+		SmallVector()
+	{
+		steal(other);
+	}
+
+	// fXgN^
+	~SmallVector()
+	{
+		this->clear();
+		free_storage();
+	}
+
+	// Zq
+	SmallVector& operator=(const SmallVector& other)
+	{
+		if (this != &other) {
+			this->clear();
+			this->reserve(other.n);
+			for (const auto& v : other) {
+				new (this->p + this->n) T(v);
+				this->n++;
+			}
+		}
+		return *this;
+	}
+	SmallVector& operator=(SmallVector&& other) noexcept
+	{
+		if (this != &other) {
+			this->clear();
+			free_storage();
+			steal(other);
+		}
+		return *this;
+	}
+	SmallVector& operator=(std::initializer_list<T> init)
+	{
+		this->clear();
+		this->reserve(init.size());
+		for (const auto& v : init) {
+			new (this->p + this->n) T(v);
+			this->n++;
+		}
+		return *this;
+	}
+
+	// vfEe
+	size_t size() const { return this->n; }
+	size_t capacity() const { return this->cap; }
+	bool empty() const { return this->n == 0; }
+
+	// vfANZX
+	T* data() { return this->p; }
+	const T* data() const { return this->p; }
+	T& operator[](size_t i) { return this->p[i]; }
+	const T& operator[](size_t i) const { return this->p[i]; }
+	T& at(size_t i) { if (i >= this->n) throw std::out_of_range("SmallVector"); return this->p[i]; }
+	const T& at(size_t i) const { if (i >= this->n) throw std::out_of_range("SmallVector"); return this->p[i]; }
+	T& front() { return this->p[0]; }
+	const T& front() const { return this->p[0]; }
+	T& back() { return this->p[this->n - 1]; }
+	const T& back() const { return this->p[this->n - 1]; }
+
+	// Ce[^
+	iterator begin() { return this->p; }
+	iterator end() { return this->p + this->n; }
+	const_iterator begin() const { return this->p; }
+	const_iterator end() const { return this->p + this->n; }
+	const_iterator cbegin() const { return this->p; }
+	const_iterator cend() const { return this->p + this->n; }
+	reverse_iterator rbegin() { return reverse_iterator(end()); }
+	reverse_iterator rend() { return reverse_iterator(begin()); }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+	// eʂm
+	void reserve(size_t new_cap)
+	{
+		if (new_cap > this->cap) grow(new_cap);
+	}
+
+	// vfǉ
+	void push_back(const T& value) { this->emplace_back(value); }
+	void push_back(T&& value) { this->emplace_back(std::move(value)); }
+	template<typename... Args>
+	T& emplace_back(Args&&... args)
+	{
+		if (this->n == this->cap) {
+			// g̗vfQƂĂꍇɔAɍ\zĂڂ
+			T tmp(std::forward<Args>(args)...);
+			grow(this->n + 1);
+			new (this->p + this->n) T(std::move(tmp));
+		}
+		else {
+			new (this->p + this->n) T(std::forward<Args>(args)...);
+		}
+		return this->p[this->n++];
+	}
+
+	// vf}
+	iterator insert(const_iterator pos, const T& value)
+	{
+		auto i = pos - this->p;
+		this->emplace_back(value);
+		std::rotate(this->p + i, this->p + this->n - 1, this->p + this->n);
+		return this->p + i;
+	}
+	template<typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+	iterator insert(const_iterator pos, InputIt first, InputIt last)
+	{
+		auto i = pos - this->p;
+		auto old_n = this->n;
+		for (; first != last; ++first) {
+			this->emplace_back(*first);
+		}
+		std::rotate(this->p + i, this->p + old_n, this->p + this->n);
+		return this->p + i;
+	}
+
+	// vf폜
+	void pop_back()
+	{
+		this->p[--this->n].~T();
+	}
+	iterator erase(const_iterator pos)
+	{
+		return this->erase(pos, pos + 1);
+	}
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		auto i = first - this->p;
+		auto count = last - first;
+		std::move(this->p + i + count, this->p + this->n, this->p + i);
+		for (difference_type k = 0; k < count; k++) {
+			this->pop_back();
+		}
+		return this->p + i;
+	}
+	void clear()
+	{
+		for (size_t i = 0; i < this->n; i++) {
+			this->p[i].~T();
+		}
+		this->n = 0;
+	}
+
+	// vfύX
+	void resize(size_t count)
+	{
+		this->reserve(count);
+		while (this->n > count) this->pop_back();
+		while (this->n < count) this->emplace_back();
+	}
+	void resize(size_t count, const T& value)
+	{
+		this->reserve(count);
+		while (this->n > count) this->pop_back();
+		while (this->n < count) this->emplace_back(value);
+	}
+
+	// 
+	void swap(SmallVector& other)
+	{
+		SmallVector tmp(std::move(other));
+		other = std::move(*this);
+		*this = std::move(tmp);
+	}
+};
+
+// rZq
+template<typename T, size_t N>
+bool operator==(const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs)
+{
+	return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+template<typename T, size_t N>
+bool operator!=(const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+// 
+template<typename T, size_t N>
+void swap(SmallVector<T, N>& lhs, SmallVector<T, N>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+}	// namespace dz
@@ -59,7 +59,7 @@ inline NdArray broadcast_to(const NdArray& in_array, const nc::Shape& shape)
 		out_array = NdArray(mat);
 	}
 	// ̃u[hLXg
-	else if (in_array.shape().rows == 1) {
+	else if (in_array.shape().cols == 1) {
 		// ̓f[^̗̃xNg擾
 		std::vector<data_t> col_vec = in_array.transpose().toStlVector();
 		// sɃu[hLXgčsɊgĂ]n
@@ -75,6 +75,92 @@ inline NdArray broadcast_to(const NdArray& in_array, const nc::Shape& shape)
 	return out_array;
 }
 
+// NdArrayp sum
+// Xbhv[ŕČvZ
+// Svf̍v͈̗vf̃ubNƂ̕aɉZ邽߁Aʂ̓XbhɈˑȂ
+inline NdArray sum(const NdArray& in_array, nc::Axis axis)
+{
+	auto rows = static_cast<size_t>(in_array.shape().rows);
+	auto cols = static_cast<size_t>(in_array.shape().cols);
+	auto p = in_array.data();
+
+	// Svf̍v
+	if (axis == nc::Axis::NONE) {
+		auto n = static_cast<size_t>(in_array.size());
+		auto grain = parallel::default_grain;
+		auto partial = std::vector<data_t>(std::max<size_t>((n + grain - 1) / grain, 1), 0);
+		parallel::parallel_for(0, partial.size(), 1, [&](size_t first, size_t last) {
+			for (auto b = first; b < last; b++) {
+				data_t s = 0;
+				for (auto i = b * grain; i < std::min(n, (b + 1) * grain); i++) s += p[i];
+				partial[b] = s;
+			}
+		});
+		data_t s = 0;
+		for (auto v : partial) s += v;
+		return NdArray({ s });
+	}
+
+	// s̍viʂ 1 x colsj
+	// ubNɕĕ񉻂Ae͍s̏ɉZ
+	if (axis == nc::Axis::ROW) {
+		auto out_array = NdArray(1, static_cast<uint32_t>(cols)).fill(0);
+		auto q = out_array.data();
+		auto grain = std::max<size_t>(parallel::default_grain / std::max<size_t>(rows, 1), 1);
+		parallel::parallel_for(0, cols, grain, [=](size_t first, size_t last) {
+			for (size_t r = 0; r < rows; r++) {
+				for (auto c = first; c < last; c++) q[c] += p[r * cols + c];
+			}
+		});
+		return out_array;
+	}
+
+	// ̍viʂ 1 x rowsj
+	auto out_array = NdArray(1, static_cast<uint32_t>(rows)).fill(0);
+	auto q = out_array.data();
+	auto grain = std::max<size_t>(parallel::default_grain / std::max<size_t>(cols, 1), 1);
+	parallel::parallel_for(0, rows, grain, [=](size_t first, size_t last) {
+		for (auto r = first; r < last; r++) {
+			data_t s = 0;
+			for (size_t c = 0; c < cols; c++) s += p[r * cols + c];
+			q[r] = s;
+		}
+	});
+	return out_array;
+}
+
+// NdArrayp̍s
+// o͂̍sXbhv[ŕAes͗ubNɕăLbVɍڂ܂܌vZ
+// evf͓ς̏ik ̏jɉZ邽߁Aʂ NdArray::dot ƈv
+inline NdArray dot(const NdArray& a, const NdArray& b)
+{
+	assert(a.shape().cols == b.shape().rows);
+	auto M = static_cast<size_t>(a.shape().rows);
+	auto K = static_cast<size_t>(a.shape().cols);
+	auto N = static_cast<size_t>(b.shape().cols);
+
+	auto c = NdArray(static_cast<uint32_t>(M), static_cast<uint32_t>(N)).fill(0);
+	auto pa = a.data();
+	auto pb = b.data();
+	auto pc = c.data();
+	constexpr size_t block = 256;
+	auto grain = std::max<size_t>(parallel::default_grain / std::max<size_t>(K * N, 1), 1);
+	parallel::parallel_for(0, M, grain, [=](size_t first, size_t last) {
+		for (size_t j0 = 0; j0 < N; j0 += block) {
+			auto j1 = std::min(j0 + block, N);
+			for (auto i = first; i < last; i++) {
+				auto ci = pc + i * N;
+				for (size_t k = 0; k < K; k++) {
+					auto aik = pa[i * K + k];
+					auto bk = pb + k * N;
+					for (auto j = j0; j < j1; j++) ci[j] += aik * bk[j];
+				}
+			}
+		}
+	});
+	return c;
+}
+
 // NdArrayp sum_to
 // NdArray͍sɎŒ肳Ă邽߂̑ȌƂ
 inline NdArray sum_to(const NdArray& in_array, const nc::Shape& shape)
@@ -87,25 +173,18 @@ inline NdArray sum_to(const NdArray& in_array, const nc::Shape& shape)
 
 	// XJ[֍v
 	if (shape.rows == 1 && shape.cols == 1) {
-		out_array = in_array.sum();
+		out_array = sum(in_array, nc::Axis::NONE);
 	}
 	// s̍v
 	else if (shape.rows == 1) {
-		out_array = NdArray(shape).fill(0);
-		// Ss[v
-		for (uint32_t r = 0; r < in_array.shape().rows; r++) {
-			// 1sZ
-			out_array += in_array(r, in_array.cSlice());
-		}
+		out_array = sum(in_array, nc::Axis::ROW);
 	}
 	// ̍v
 	else if (shape.cols == 1) {
-		out_array = NdArray(shape).fill(0);
-		// Ss[v
-		for (uint32_t c = 0; c < in_array.shape().cols; c++) {
-			// 1񂸂Z
-			out_array += in_array(in_array.rSlice(), c);
-		}
+		// es̍v͍sxNgœ邽ߗxNgɋlߑւ
+		auto row_sums = sum(in_array, nc::Axis::COL);
+		out_array = NdArray(shape);
+		std::copy(row_sums.begin(), row_sums.end(), out_array.begin());
 	}
 	else {
 		out_array = in_array;
@@ -124,6 +203,460 @@ inline void broadcast_mutual(NdArray& a0, NdArray& a1)
 	a1 = broadcast_to(a1, a0_shape);
 }
 
+//----------------------------------
+// Higher-order Differentiation
+//----------------------------------
+
+// wbZsƃxNg̐ (Hessian-vector product)
+// loss_fn  params gđvZ֐B߂l params Ɠт Hv
+// params ɐڐ v ^ď`dÂ܂܋t`dƌz̐ڐƂ Hv iforward-over-reversej
+// t`ďvZOticreate_graphjȂ߁Agpʂ͏`d̊lƐڐ̕ōς
+inline NdArrayPtrList hvp(const std::function<VariablePtr()>& loss_fn, const VariablePtrList& params, const NdArrayPtrList& v)
+{
+	assert(params.size() == v.size());
+
+	// ̌z͑ޔĂ
+	auto old_grads = VariablePtrList();
+	for (size_t i = 0; i < params.size(); i++) {
+		old_grads.push_back(params[i]->grad);
+		params[i]->cleargrad();
+		params[i]->tangent = v[i];
+	}
+
+	// ڐtŏ`dt`d
+	auto loss = loss_fn();
+	loss->backward();
+
+	// z̐ڐoČɖ߂
+	auto hv = NdArrayPtrList();
+	for (size_t i = 0; i < params.size(); i++) {
+		const auto& p = params[i];
+		if (p->grad && p->grad->tangent) hv.push_back(p->grad->tangent);
+		else hv.push_back(as_array(nc::zeros_like<data_t>(*p->data)));
+		p->tangent = nullptr;
+		p->grad = old_grads[i];
+	}
+	return hv;
+}
+
+// RrsƃxNg̐ (Jacobian-vector product)
+//  xs ɐڐ txs ^ func `dAo͂Ƃ̐ڐ̑gԂi[h̔j
+// vZOt͍Ȃ
+inline std::pair<VariablePtrList, NdArrayPtrList> jvp(const std::function<F::function_t>& func, const VariablePtrList& xs, const NdArrayPtrList& txs)
+{
+	assert(xs.size() == txs.size());
+	no_grad ng;
+
+	// Ăяo̕ϐȂ悤Vϐɐڐݒ肷
+	auto inputs = VariablePtrList();
+	for (size_t i = 0; i < xs.size(); i++) {
+		inputs.push_back(as_variable(xs[i]->data));
+		inputs.back()->tangent = txs[i];
+	}
+	auto outputs = func(inputs);
+
+	// ڐȂói͂ɈˑȂój̓[Ƃ
+	auto tys = NdArrayPtrList();
+	for (auto& o : outputs) {
+		tys.push_back(o->tangent ? o->tangent : as_array(nc::zeros_like<data_t>(*o->data)));
+		o->tangent = nullptr;
+	}
+	return { outputs, tys };
+}
+
+// RršvZ@
+enum class JacobianMode
+{
+	Auto,		// o̗͂vf玩őI
+	Forward,	// [hi̗͂vf`dj
+	Reverse,	// t[hio̗͂vft`dj
+};
+
+// Rrs
+// ߂l (o̗͂vf, ̗͂vf) ̍s
+// ͂Ȃo͂ꍇ͏[hAt̏ꍇ͋t[h̕pXȂ
+inline NdArray jacobian(const std::function<VariablePtr(const VariablePtr&)>& func, const VariablePtr& x, JacobianMode mode = JacobianMode::Auto)
+{
+	auto n = static_cast<uint32_t>(x->data->size());
+
+	// [hF̗͂vfƂɒPʃxNg̐ڐ^ăRrs̗߂
+	auto forward_column = [&](uint32_t j) {
+		auto t = as_array(nc::zeros_like<data_t>(*x->data));
+		(*t)[j] = 1;
+		auto f = [&func](const VariablePtrList& xs) { return VariablePtrList({ func(xs[0]) }); };
+		return jvp(f, { x }, { t }).second[0];
+	};
+
+	if (mode == JacobianMode::Auto) {
+		// o̗͂vfm邽߂Ɉx`d
+		auto m = [&]() { no_grad ng; return func(x)->data->size(); }();
+		mode = n <= m ? JacobianMode::Forward : JacobianMode::Reverse;
+	}
+
+	if (mode == JacobianMode::Forward) {
+		auto J = NdArray();
+		for (uint32_t j = 0; j < n; j++) {
+			auto col = forward_column(j);
+			if (j == 0) J = NdArray(col->size(), n).fill(0);
+			for (uint32_t i = 0; i < col->size(); i++) J(i, j) = (*col)[i];
+		}
+		return J;
+	}
+
+	// t[hFvZOtPxAo̗͂vfƂɒPʃxNǧzt`dčs߂
+	UsingConfig with("release_data", false);
+	auto xv = as_variable(x->data);
+	auto y = func(xv);
+	auto m = y->data->size();
+	auto J = NdArray(m, n).fill(0);
+	for (uint32_t i = 0; i < m; i++) {
+		auto g = as_array(nc::zeros_like<data_t>(*y->data));
+		(*g)[i] = 1;
+		xv->cleargrad();
+		y->grad = as_variable(g);
+		y->backward();
+		if (!xv->grad) continue;
+		for (uint32_t j = 0; j < n; j++) J(i, j) = (*xv->grad->data)[j];
+	}
+	return J;
+}
+
+//----------------------------------
+// Per-sample Gradient
+//----------------------------------
+
+// TvƂ̌zNbvčvivCoV[j
+// eTvɂđSp[^ɂ킽z̃m߁Amax_norm 𒴂̂ max_norm ɏk߂Ă獇v grad ɐݒ肷
+// ߂l̓NbvÕTvƂ̃m
+// TvƂ̌z Config  per_sample_grad Lɂċt`dƓ
+// mean_loss ̓ob`ς̑imean_squared_error Ȃǁj狁߂zB̏ꍇ̊es 1/N {ꂽzȂ̂ŁA
+// @m N {ĕ]Agrad ̓Nbvz̕ςɂȂBv̑狁߂ꍇ false w肷
+template<typename T>
+inline std::vector<data_t> clip_and_sum_grad_samples(const T& params, data_t max_norm, bool mean_loss = true)
+{
+	auto ps = std::vector<ParameterPtr>();
+	for (const auto& v : params) {
+		auto p = node_cast<Parameter>(v);
+		if (p && p->grad_sample) ps.push_back(p);
+	}
+	if (ps.empty()) return {};
+	auto N = static_cast<size_t>(ps[0]->grad_sample->shape().rows);
+	data_t scale = mean_loss ? static_cast<data_t>(N) : 1;
+
+	// TvƂ̃m
+	auto norms = std::vector<data_t>(N, 0);
+	parallel::parallel_for(0, N, 1, [&](size_t first, size_t last) {
+		for (auto n = first; n < last; n++) {
+			data_t s = 0;
+			for (const auto& p : ps) {
+				auto cols = static_cast<size_t>(p->grad_sample->shape().cols);
+				auto row = p->grad_sample->data() + n * cols;
+				for (size_t k = 0; k < cols; k++) s += row[k] * row[k];
+			}
+			norms[n] = scale * std::sqrt(s);
+		}
+	});
+
+	// NbvW
+	auto factors = std::vector<data_t>(N);
+	for (size_t n = 0; n < N; n++) {
+		factors[n] = std::min<data_t>(1, max_norm / (norms[n] + 1e-6));
+	}
+
+	// Nbvz̍v
+	for (const auto& p : ps) {
+		auto g = pooled_array(p->data->shape());
+		auto cols = static_cast<size_t>(p->grad_sample->shape().cols);
+		auto src = p->grad_sample->data();
+		auto dst = g->data();
+		parallel::parallel_for(0, cols, parallel::default_grain / std::max<size_t>(N, 1), [&](size_t first, size_t last) {
+			std::fill(dst + first, dst + last, data_t(0));
+			for (size_t n = 0; n < N; n++) {
+				auto f = factors[n];
+				for (auto k = first; k < last; k++) dst[k] += f * src[n * cols + k];
+			}
+		});
+		p->grad = as_variable(g);
+	}
+	return norms;
+}
+
+//----------------------------------
+// Gradient Check
+//----------------------------------
+
+// zmF̌
+struct GradCheckResult
+{
+	// Ώۂ̖
+	std::string name;
+	// rz̐
+	size_t count = 0;
+	// ő告Ό덷
+	data_t max_rel_error = 0;
+	// e덷
+	bool passed = false;
+};
+
+// lƋt`ďzr
+// o͂ɗ̏d w |a sum(w * func(xs)) 𑹎ƂA͂Ƃ̌z𒆐SƔׂ
+// ̗͂vf̍v max_elements ȉȂSvfPA𒴂ꍇ͑Svf𓯎 }1 ̗֓ num_directions ׂ
+// ̕]̓Xbhv[ŕɍs
+// Ό덷 |a - n| / max(1, |a| + |n|) Ƃizꍇ͐Ό덷ŕ]j
+inline GradCheckResult gradient_check(const std::string& name, const std::function<F::function_t>& func, const VariablePtrList& xs,
+	data_t eps = 1e-6, data_t tol = 1e-5, size_t max_elements = 4096, size_t num_directions = 32)
+{
+	auto result = GradCheckResult();
+	result.name = name;
+
+	// o͂̏d݁iČ̂ߌŒV[hj
+	auto engine = std::mt19937_64(0);
+	auto dist = std::uniform_real_distribution<data_t>(-1, 1);
+	auto ws = NdArrayPtrList();
+	{
+		no_grad ng;
+		auto inputs = VariablePtrList();
+		for (const auto& x : xs) inputs.push_back(as_variable(as_array(*x->data)));
+		for (const auto& y : func(inputs)) {
+			auto w = as_array(nc::zeros_like<data_t>(*y->data));
+			for (auto& v : *w) v = dist(engine);
+			ws.push_back(w);
+		}
+	}
+
+	// N[WF̓f[^o̓f[^߂ivZOt͍Ȃj
+	auto evaluate = [&func](const NdArrayPtrList& datas) {
+		no_grad ng;
+		auto inputs = VariablePtrList();
+		for (const auto& d : datas) inputs.push_back(as_variable(d));
+		auto ys = NdArrayPtrList();
+		for (const auto& y : func(inputs)) ys.push_back(y->data);
+		return ys;
+	};
+	// N[WFQ̏o̓f[^̑̍ sum(w * (yp - ym)) ߂
+	// ǂƗvfꍇɌ邽߁AvfƂɍĂ瑫킹
+	auto loss_diff = [&ws](const NdArrayPtrList& yps, const NdArrayPtrList& yms) {
+		data_t diff = 0;
+		for (size_t k = 0; k < yps.size(); k++) {
+			const auto& yp = *yps[k];
+			const auto& ym = *yms[k];
+			for (uint32_t i = 0; i < yp.size(); i++) diff += (*ws[k])[i] * (yp[i] - ym[i]);
+		}
+		return diff;
+	};
+	// N[WF̓f[^̕
+	auto copy_inputs = [&xs]() {
+		auto datas = NdArrayPtrList();
+		for (const auto& x : xs) datas.push_back(as_array(*x->data));
+		return datas;
+	};
+	// N[WFΌ덷L^
+	std::mutex mtx;
+	auto record = [&](data_t analytic, data_t numeric) {
+		auto err = std::abs(analytic - numeric) / std::max<data_t>(1, std::abs(analytic) + std::abs(numeric));
+		std::lock_guard<std::mutex> lock(mtx);
+		result.max_rel_error = std::max(result.max_rel_error, err);
+		result.count++;
+	};
+
+	// t`dɂz
+	auto grads = NdArrayPtrList();
+	{
+		UsingConfig with("enable_backprop", true);
+		auto inputs = VariablePtrList();
+		for (const auto& x : xs) inputs.push_back(as_variable(as_array(*x->data)));
+		auto ys = func(inputs);
+		auto loss = VariablePtr();
+		for (size_t k = 0; k < ys.size(); k++) {
+			auto t = F::sum(ys[k] * as_variable(ws[k]));
+			loss = loss ? loss + t : t;
+		}
+		loss->backward();
+		for (const auto& x : inputs) {
+			grads.push_back(x->grad ? x->grad->data : as_array(nc::zeros_like<data_t>(*x->data)));
+		}
+	}
+
+	// Svf̈ʒui͔ԍ, vfԍj
+	auto positions = std::vector<std::pair<size_t, uint32_t>>();
+	for (size_t k = 0; k < xs.size(); k++) {
+		for (uint32_t i = 0; i < xs[k]->data->size(); i++) positions.emplace_back(k, i);
+	}
+
+	if (positions.size() <= max_elements) {
+		// vfƂ̒Si^XNƂɓ͂𕡐ĂPvfj
+		parallel::parallel_for(0, positions.size(), 16, [&](size_t first, size_t last) {
+			auto datas = copy_inputs();
+			for (auto j = first; j < last; j++) {
+				auto [k, i] = positions[j];
+				auto& v = (*datas[k])[i];
+				auto org = v;
+				v = org + eps;
+				auto yps = evaluate(datas);
+				v = org - eps;
+				auto yms = evaluate(datas);
+				v = org;
+				record((*grads[k])[i], loss_diff(yps, yms) / (2 * eps));
+			}
+		});
+	}
+	else {
+		// Svf𓯎ɓiƂɕj
+		parallel::parallel_for(0, num_directions, 1, [&](size_t first, size_t last) {
+			for (auto d = first; d < last; d++) {
+				auto dir_engine = std::mt19937_64(d + 1);
+				auto plus = copy_inputs();
+				auto minus = copy_inputs();
+				data_t analytic = 0;
+				for (size_t k = 0; k < xs.size(); k++) {
+					for (uint32_t i = 0; i < xs[k]->data->size(); i++) {
+						data_t s = (dir_engine() & 1) ? 1 : -1;
+						(*plus[k])[i] += s * eps;
+						(*minus[k])[i] -= s * eps;
+						analytic += s * (*grads[k])[i];
+					}
+				}
+				record(analytic, loss_diff(evaluate(plus), evaluate(minus)) / (2 * eps));
+			}
+		});
+	}
+
+	result.passed = result.max_rel_error <= tol;
+	return result;
+}
+
+// S֐NX̌zmF
+// rows x cols ̗͂Ƃ core.hpp  functions.hpp ̊e֐NX̌zmFA֐Ƃ̌ʂԂ
+inline std::vector<GradCheckResult> gradient_check_all(uint32_t rows = 8, uint32_t cols = 6, data_t tol = 1e-5)
+{
+	auto engine = std::mt19937_64(1);
+	auto dist = std::uniform_real_distribution<data_t>(0.5, 1.5);
+	auto rand = [&](uint32_t r, uint32_t c) {
+		auto a = as_array(nc::zeros<data_t>({ r, c }));
+		for (auto& v : *a) v = dist(engine);
+		return as_variable(a);
+	};
+	auto unary = [](VariablePtr(*f)(const VariablePtr&)) {
+		return [f](const VariablePtrList& xs) { return VariablePtrList({ f(xs[0]) }); };
+	};
+
+	auto x = rand(rows, cols);
+	auto x1 = rand(rows, cols);
+	auto row = rand(1, cols);
+	auto W = rand(cols, 4);
+	auto b = rand(1, 4);
+
+	using check_t = std::tuple<std::string, std::function<F::function_t>, VariablePtrList>;
+	auto checks = std::vector<check_t>({
+		{ "Add", [](const VariablePtrList& xs) { return VariablePtrList({ xs[0] + xs[1] }); }, { x, x1 } },
+		{ "Add (broadcast)", [](const VariablePtrList& xs) { return VariablePtrList({ xs[0] + xs[1] }); }, { x, row } },
+		{ "Sub", [](const VariablePtrList& xs) { return VariablePtrList({ xs[0] - xs[1] }); }, { x, x1 } },
+		{ "Mul", [](const VariablePtrList& xs) { return VariablePtrList({ xs[0] * xs[1] }); }, { x, x1 } },
+		{ "Div", [](const VariablePtrList& xs) { return VariablePtrList({ xs[0] / xs[1] }); }, { x, x1 } },
+		{ "Pos", [](const VariablePtrList& xs) { return VariablePtrList({ +xs[0] }); }, { x } },
+		{ "Neg", [](const VariablePtrList& xs) { return VariablePtrList({ -xs[0] }); }, { x } },
+		{ "Pow", [](const VariablePtrList& xs) { return VariablePtrList({ power(xs[0], 3) }); }, { x } },
+		{ "AddScalar", [](const VariablePtrList& xs) { return VariablePtrList({ xs[0] + 2.0 }); }, { x } },
+		{ "SubScalar", [](const VariablePtrList& xs) { return VariablePtrList({ xs[0] - 2.0 }); }, { x } },
+		{ "RSub", [](const VariablePtrList& xs) { return VariablePtrList({ 2.0 - xs[0] }); }, { x } },
+		{ "MulScalar", [](const VariablePtrList& xs) { return VariablePtrList({ xs[0] * 2.0 }); }, { x } },
+		{ "DivScalar", [](const VariablePtrList& xs) { return VariablePtrList({ xs[0] / 2.0 }); }, { x } },
+		{ "RDiv", [](const VariablePtrList& xs) { return VariablePtrList({ 2.0 / xs[0] }); }, { x } },
+		{ "Sin", unary(F::sin), { x } },
+		{ "Cos", unary(F::cos), { x } },
+		{ "Tanh", unary(F::tanh), { x } },
+		{ "Exp", unary(F::exp), { x } },
+		{ "Sigmoid", unary(F::sigmoid), { x } },
+		{ "Reshape", [cols, rows](const VariablePtrList& xs) { return VariablePtrList({ F::reshape(xs[0], { cols, rows }) }); }, { x } },
+		{ "Transpose", [](const VariablePtrList& xs) { return VariablePtrList({ F::transpose(xs[0]) }); }, { x } },
+		{ "Sum", [](const VariablePtrList& xs) { return VariablePtrList({ F::sum(xs[0]) }); }, { x } },
+		{ "BroadcastTo", [rows, cols](const VariablePtrList& xs) { return VariablePtrList({ F::broadcast_to(xs[0], { rows, cols }) }); }, { row } },
+		{ "SumTo", [cols](const VariablePtrList& xs) { return VariablePtrList({ F::sum_to(xs[0], { 1, cols }) }); }, { x } },
+		{ "MatMul", [](const VariablePtrList& xs) { return VariablePtrList({ F::matmul(xs[0], xs[1]) }); }, { x, W } },
+		{ "Linear", [](const VariablePtrList& xs) { return VariablePtrList({ F::linear(xs[0], xs[1], xs[2]) }); }, { x, W, b } },
+		{ "MeanSquaredError", [](const VariablePtrList& xs) { return VariablePtrList({ F::mean_squared_error(xs[0], xs[1]) }); }, { x, x1 } },
+		{ "Softmax", [](const VariablePtrList& xs) { return VariablePtrList({ F::softmax(xs[0]) }); }, { x } },
+		{ "Softmax (axis COL)", [](const VariablePtrList& xs) { return VariablePtrList({ F::softmax(xs[0], nc::Axis::COL) }); }, { x } },
+		{ "Checkpoint", [](const VariablePtrList& xs) {
+			return F::checkpoint([](const VariablePtrList& ys) { return VariablePtrList({ F::tanh(ys[0]) * ys[1] }); }, xs);
+		}, { x, x1 } },
+	});
+
+	auto results = std::vector<GradCheckResult>();
+	for (const auto& [name, func, xs] : checks) {
+		results.push_back(gradient_check(name, func, xs, 1e-6, tol));
+	}
+	return results;
+}
+
+// wbZsƃxNg̐ς̊mF
+// ̕ v ɂ hvp ̌ʂz̒S (L(p + eps v) - L(p - eps v)) / 2eps ƗvfƂɔׂ
+// params ̃f[^ƌz͈ꎞIɏĕ]AIɌ֖߂
+inline GradCheckResult hvp_check(const std::string& name, const std::function<VariablePtr()>& loss_fn, const VariablePtrList& params,
+	data_t eps = 1e-5, data_t tol = 1e-5)
+{
+	auto result = GradCheckResult();
+	result.name = name;
+
+	// ̃f[^ƌzޔ
+	auto org_datas = NdArrayPtrList();
+	auto old_grads = VariablePtrList();
+	for (const auto& p : params) {
+		org_datas.push_back(as_array(*p->data));
+		old_grads.push_back(p->grad);
+	}
+
+	// iČ̂ߌŒV[hj
+	auto engine = std::mt19937_64(0);
+	auto dist = std::uniform_real_distribution<data_t>(-1, 1);
+	auto v = NdArrayPtrList();
+	for (const auto& p : params) {
+		auto d = as_array(nc::zeros_like<data_t>(*p->data));
+		for (auto& e : *d) e = dist(engine);
+		v.push_back(d);
+	}
+
+	auto hv = hvp(loss_fn, params, v);
+
+	// N[WFparams  s * eps * v ʒuł̌zif[^͌ɖ߂j
+	auto grads_at = [&](data_t s) {
+		for (size_t k = 0; k < params.size(); k++) {
+			auto& d = *params[k]->data;
+			for (uint32_t i = 0; i < d.size(); i++) d[i] = (*org_datas[k])[i] + s * eps * (*v[k])[i];
+			params[k]->cleargrad();
+		}
+		loss_fn()->backward();
+		auto grads = NdArrayPtrList();
+		for (size_t k = 0; k < params.size(); k++) {
+			const auto& p = params[k];
+			grads.push_back(p->grad ? as_array(*p->grad->data) : as_array(nc::zeros_like<data_t>(*p->data)));
+			auto& d = *p->data;
+			for (uint32_t i = 0; i < d.size(); i++) d[i] = (*org_datas[k])[i];
+		}
+		return grads;
+	};
+	auto gp = grads_at(1);
+	auto gm = grads_at(-1);
+
+	for (size_t k = 0; k < params.size(); k++) {
+		for (uint32_t i = 0; i < hv[k]->size(); i++) {
+			auto analytic = (*hv[k])[i];
+			auto numeric = ((*gp[k])[i] - (*gm[k])[i]) / (2 * eps);
+			auto err = std::abs(analytic - numeric) / std::max<data_t>(1, std::abs(analytic) + std::abs(numeric));
+			result.max_rel_error = std::max(result.max_rel_error, err);
+			result.count++;
+		}
+	}
+
+	// zɖ߂
+	for (size_t k = 0; k < params.size(); k++) {
+		params[k]->grad = old_grads[k];
+	}
+
+	result.passed = result.max_rel_error <= tol;
+	return result;
+}
+
 //----------------------------------
 // DOT Language
 //----------------------------------
@@ -136,6 +669,11 @@ static uintptr_t id(const std::shared_ptr<T>& d)
 	// std::shared_ptr ^̂ݎgpł悤ɐ
 	return reinterpret_cast<uintptr_t>(&*d);
 }
+template<typename T>
+static uintptr_t id(const Ref<T>& d)
+{
+	return reinterpret_cast<uintptr_t>(d.get());
+}
 
 // VariableDOTo
 static std::string dot_var(const VariablePtr& v, bool verbose = false)
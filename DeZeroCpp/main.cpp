@@ -53,11 +53,143 @@ namespace step43 { extern void step43(); }
 namespace step44 { extern void step44(); }
 namespace step45 { extern void step45(); }
 namespace step46 { extern void step46(); }
+namespace bench_optimizer_update { extern void bench_optimizer_update(); }
+namespace bench_checkpoint { extern void bench_checkpoint(); }
+namespace bench_release { extern void bench_release(); }
+namespace bench_buffer_pool { extern void bench_buffer_pool(); }
+namespace bench_scalar_graph { extern void bench_scalar_graph(); }
+namespace bench_parallel_backward { extern void bench_parallel_backward(); }
+namespace bench_op_threads { extern void bench_op_threads(); }
+namespace check_parallel_seed { extern bool check_parallel_seed(); }
+namespace check_broadcast { extern bool check_broadcast(); }
+namespace bench_hvp { extern void bench_hvp(); }
+namespace bench_jacobian { extern void bench_jacobian(); }
+namespace check_gradients { extern bool check_gradients(); }
+namespace bench_ref { extern void bench_ref(); }
+namespace bench_small_vector { extern void bench_small_vector(); }
 
-int main()
+// 名前で選んで実行できるステップとベンチマーク
+const std::vector<std::pair<std::string, void(*)()>> programs = {
+	{ "step01", step01::step01 },
+	{ "step02", step02::step02 },
+	{ "step03", step03::step03 },
+	{ "step04", step04::step04 },
+	{ "step05", step05::step05 },
+	{ "step06", step06::step06 },
+	{ "step07", step07::step07 },
+	{ "step08", step08::step08 },
+	{ "step09", step09::step09 },
+	{ "step10", step10::step10 },
+	{ "step11", step11::step11 },
+	{ "step12", step12::step12 },
+	{ "step13", step13::step13 },
+	{ "step14", step14::step14 },
+	{ "step15", step15::step15 },
+	{ "step16", step16::step16 },
+	{ "step17", step17::step17 },
+	{ "step18", step18::step18 },
+	{ "step19", step19::step19 },
+	{ "step20", step20::step20 },
+	{ "step21", step21::step21 },
+	{ "step22", step22::step22 },
+	{ "step23", step23::step23 },
+	{ "step24", step24::step24 },
+	{ "step25", step25::step25 },
+	{ "step26", step26::step26 },
+	{ "step27", step27::step27 },
+	{ "step28", step28::step28 },
+	{ "step29", step29::step29 },
+	{ "step30", step30::step30 },
+	{ "step31", step31::step31 },
+	{ "step32", step32::step32 },
+	{ "step33", step33::step33 },
+	{ "step34", step34::step34 },
+	{ "step35", step35::step35 },
+	{ "step36", step36::step36 },
+	{ "step37", step37::step37 },
+	{ "step38", step38::step38 },
+	{ "step39", step39::step39 },
+	{ "step40", step40::step40 },
+	{ "step41", step41::step41 },
+	{ "step42", step42::step42 },
+	{ "step43", step43::step43 },
+	{ "step44", step44::step44 },
+	{ "step45", step45::step45 },
+	{ "step46", step46::step46 },
+	{ "bench_optimizer_update", bench_optimizer_update::bench_optimizer_update },
+	{ "bench_checkpoint", bench_checkpoint::bench_checkpoint },
+	{ "bench_release", bench_release::bench_release },
+	{ "bench_buffer_pool", bench_buffer_pool::bench_buffer_pool },
+	{ "bench_scalar_graph", bench_scalar_graph::bench_scalar_graph },
+	{ "bench_parallel_backward", bench_parallel_backward::bench_parallel_backward },
+	{ "bench_op_threads", bench_op_threads::bench_op_threads },
+	{ "bench_hvp", bench_hvp::bench_hvp },
+	{ "bench_jacobian", bench_jacobian::bench_jacobian },
+	{ "bench_ref", bench_ref::bench_ref },
+	{ "bench_small_vector", bench_small_vector::bench_small_vector },
+};
+
+// 名前で選んで実行できる確認（結果が正しければ true を返す）
+const std::vector<std::pair<std::string, bool(*)()>> checks = {
+	{ "check_parallel_seed", check_parallel_seed::check_parallel_seed },
+	{ "check_broadcast", check_broadcast::check_broadcast },
+	{ "check_gradients", check_gradients::check_gradients },
+};
+
+// 全ての確認を実行し、確認ごとの結果を表示する
+// 全て正しければ true を返す
+bool run_all_checks()
+{
+	auto results = std::vector<std::pair<std::string, bool>>();
+	for (const auto& c : checks) {
+		std::cout << "== " << c.first << std::endl;
+		results.emplace_back(c.first, c.second());
+	}
+	bool all_passed = true;
+	std::cout << "== summary" << std::endl;
+	for (const auto& r : results) {
+		std::printf("  %-28s %8s\n", r.first.c_str(), r.second ? "OK" : "NG");
+		all_passed = all_passed && r.second;
+	}
+	return all_passed;
+}
+
+int main(int argc, char* argv[])
 {
 	// 標準出力の小数点以下桁数を 15 とする
 	std::cout << std::fixed << std::setprecision(15);
 
-	step46::step46();
+	// 引数なしの場合は最後のステップを実行する
+	if (argc < 2) {
+		step46::step46();
+		return 0;
+	}
+
+	// 引数に並べた名前のものを順に実行する（"checks" は全ての確認）
+	// ※確認が１つでも失敗した場合は 1、名前が見つからない場合は 2 を返す
+	bool all_passed = true;
+	for (int i = 1; i < argc; i++) {
+		auto name = std::string(argv[i]);
+		if (name == "checks") {
+			all_passed = run_all_checks() && all_passed;
+			continue;
+		}
+		auto program = std::find_if(programs.begin(), programs.end(), [&](const auto& p) { return p.first == name; });
+		if (program != programs.end()) {
+			program->second();
+			continue;
+		}
+		auto check = std::find_if(checks.begin(), checks.end(), [&](const auto& c) { return c.first == name; });
+		if (check != checks.end()) {
+			all_passed = check->second() && all_passed;
+			continue;
+		}
+		std::cerr << "unknown name: " << name << std::endl;
+		std::cerr << "available: checks";
+		for (const auto& p : programs) std::cerr << " " << p.first;
+		for (const auto& c : checks) std::cerr << " " << c.first;
+		std::cerr << std::endl;
+		return 2;
+	}
+	return all_passed ? 0 : 1;
 }
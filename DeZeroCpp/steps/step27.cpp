@@ -17,16 +17,6 @@ public:
 		auto y = nc::sin(x);
 		return { as_array(y) };
 	}
-#ifdef IS_SIMPLE_CORE
-	// t`d
-	NdArrayPtrList backward(const NdArrayPtrList& gys) override
-	{
-		auto gy = *(gys[0]);
-		auto x = *(this->inputs[0]->data);
-		auto gx = gy * nc::cos(x);
-		return { as_array(gx) };
-	}
-#else
 	// t`d
 	VariablePtrList backward(const VariablePtrList& gys) override
 	{
@@ -35,12 +25,11 @@ public:
 		auto gx = *gy->data * nc::cos(*x->data);
 		return { as_variable(as_array(gx)) };
 	}
-#endif	// #ifdef IS_SIMPLE_CORE
 };
 
 VariablePtr sin(const VariablePtr& x)
 {
-	return (*std::shared_ptr<Function>(new Sin()))({ x })[0];
+	return (*FunctionPtr(new Sin()))({ x })[0];
 }
 
 VariablePtr my_sin(const VariablePtr& x, double threshold = 0.0001)
@@ -89,11 +78,7 @@ void step27()
 		y->backward();
 
 		std::cout << NdArrayPrinter(y->data) << std::endl;
-#ifdef IS_SIMPLE_CORE
-		std::cout << NdArrayPrinter(x->grad) << std::endl;
-#else
 		std::cout << x->grad << std::endl;
-#endif	// #ifdef IS_SIMPLE_CORE
 		std::cout << std::endl;
 	}
 	{
@@ -102,11 +87,7 @@ void step27()
 		y->backward();
 
 		std::cout << NdArrayPrinter(y->data) << std::endl;
-#ifdef IS_SIMPLE_CORE
-		std::cout << NdArrayPrinter(x->grad) << std::endl;
-#else
 		std::cout << x->grad << std::endl;
-#endif	// #ifdef IS_SIMPLE_CORE
 		std::cout << std::endl;
 
 		x->name = "x";
@@ -70,7 +70,7 @@ void step44()
 			for (auto* pl : { &l1, &l2 }) {
 				auto& l = *pl;
 				for (auto& p : l.params()) {
-					*(p->data) -= lr * *(p->grad->data);
+					expr::ref(*p->data) -= lr * expr::ref(*p->grad->data);
 				}
 			}
 
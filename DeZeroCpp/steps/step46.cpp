@@ -38,7 +38,7 @@ void step46()
 			loss->backward();
 
 			for (auto& p : model.params()) {
-				*(p->data) -= lr * *(p->grad->data);
+				expr::ref(*p->data) -= lr * expr::ref(*p->grad->data);
 			}
 
 			// 1000񂸂o